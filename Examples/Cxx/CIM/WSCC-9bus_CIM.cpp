@@ -55,6 +55,7 @@ int main(int argc, char *argv[]) {
 	sim.setFinalTime(0.1);
 	sim.doSteadyStateInit(true);
 	sim.addLogger(logger);
+	sim.doVectorLogging();
 	sim.run();
 
 	return 0;
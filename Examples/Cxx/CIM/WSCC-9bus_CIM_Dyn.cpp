@@ -58,6 +58,7 @@ int main(int argc, char *argv[]) {
 	sim.setFinalTime(2);
 	sim.doSteadyStateInit(true);
 	sim.addLogger(logger);
+	sim.doVectorLogging();
 	sim.run();
 
 	//std::ofstream ofTopo("topology_graph.svg");
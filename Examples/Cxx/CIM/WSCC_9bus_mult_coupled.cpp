@@ -99,6 +99,7 @@ void simulateCoupled(std::list<fs::path> filenames, Int copies, Int threads, Int
 	//}
 	//sim.addLogger(logger);
 
+	sim.doStepTimeRecording();
 	sim.run();
 	sim.logStepTimes(simName + "_step_times");
 }
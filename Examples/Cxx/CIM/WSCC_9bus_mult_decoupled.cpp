@@ -83,6 +83,7 @@ void simulateDecoupled(std::list<fs::path> filenames, Int copies, Int threads, I
 	//std::ofstream of1("topology_graph.svg");
 	//sys.topologyGraph().render(of1));
 
+	sim.doStepTimeRecording();
 	sim.run();
 	sim.logStepTimes(simName + "_step_times");
 }
@@ -0,0 +1,327 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <chrono>
+#include <cstdio>
+#include <algorithm>
+#include <iostream>
+#include <list>
+
+#include <DPsim.h>
+#include <dpsim/SequentialScheduler.h>
+#include <dpsim/ThreadLevelScheduler.h>
+#include <dpsim/ThreadListScheduler.h>
+#include <dpsim/ThreadHEFTScheduler.h>
+#include <dpsim/ThreadPoolScheduler.h>
+
+using namespace DPsim;
+using namespace CPS;
+
+/*
+ * Runs a fixed set of scenarios built from the example grids and prints
+ * the timings of the simulation phases as JSON to stdout.
+ *
+ * Each grid is only simulated in the domains of its examples: the Matpower
+ * cases as SP power flow and the coupled WSCC 9-bus systems as DP and EMT
+ * dynamic simulation. The other combinations are reported as skipped.
+ *
+ * Options:
+ *   -o copies=N    largest number of copies of the coupled WSCC 9-bus system (default 8)
+ *   -o threads=N   number of threads of the parallel schedulers (default 4)
+ *   -t, -d         time step and duration of each scenario
+ */
+
+struct Grid {
+	String name;
+	/// CIM files, which are searched when the scenario is run so that
+	/// a missing grid only fails its own scenarios
+	std::list<fs::path> filenames;
+	fs::path searchPath;
+	Real frequency;
+	Int copies;
+	/// Domains in which the grid is simulated
+	std::vector<Domain> domains;
+};
+
+struct BenchResult {
+	String grid;
+	Int copies;
+	String domain;
+	String scheduler;
+	UInt nodes = 0;
+	Int steps = 0;
+	Real initialize = 0;
+	Real factorization = 0;
+	Real stepMean = 0;
+	Real stepP99 = 0;
+	Real logging = 0;
+	String error;
+	/// Reason why the scenario was not run
+	String skipped;
+};
+
+/// Adds lines between the copies of the WSCC 9-bus system, see WSCC_9bus_mult_coupled.cpp
+template <typename NodeType, typename ResType, typename IndType, typename CapType, typename ParamType>
+void multiply_connected(SystemTopology& sys, int copies,
+	ParamType resistance, ParamType inductance, ParamType capacitance) {
+
+	sys.multiply(copies);
+	int counter = 0;
+	std::vector<String> nodes = {"BUS5", "BUS8", "BUS6"};
+
+	for (auto orig_node : nodes) {
+		std::vector<String> nodeNames{orig_node};
+		for (int i = 2; i < copies+2; i++) {
+			nodeNames.push_back(orig_node + "_" + std::to_string(i));
+		}
+		nodeNames.push_back(orig_node);
+
+		int nlines = copies == 1 ? 1 : copies+1;
+		for (int i = 0; i < nlines; i++) {
+			auto rl_node = NodeType::make("N_add_" + std::to_string(counter), sys.node<NodeType>(nodeNames[i])->phaseType());
+			auto res = ResType::make("R_" + std::to_string(counter));
+			res->setParameters(resistance);
+			auto ind = IndType::make("L_" + std::to_string(counter));
+			ind->setParameters(inductance);
+			auto cap1 = CapType::make("C1_" + std::to_string(counter));
+			cap1->setParameters(capacitance / 2.);
+			auto cap2 = CapType::make("C2_" + std::to_string(counter));
+			cap2->setParameters(capacitance / 2.);
+
+			sys.addNode(rl_node);
+			res->connect({sys.node<NodeType>(nodeNames[i]), rl_node});
+			ind->connect({rl_node, sys.node<NodeType>(nodeNames[i+1])});
+			cap1->connect({sys.node<NodeType>(nodeNames[i]), NodeType::GND});
+			cap2->connect({sys.node<NodeType>(nodeNames[i+1]), NodeType::GND});
+			counter += 1;
+
+			sys.addComponent(res);
+			sys.addComponent(ind);
+			sys.addComponent(cap1);
+			sys.addComponent(cap2);
+		}
+	}
+}
+
+SystemTopology loadSystem(const Grid& grid, Domain domain) {
+	CIM::Reader reader(grid.name, Logger::Level::off, Logger::Level::off);
+	std::list<fs::path> filenames = DPsim::Utils::findFiles(grid.filenames, grid.searchPath, "CIMPATH");
+	SystemTopology sys = reader.loadCIM(grid.frequency, filenames, domain);
+
+	if (grid.copies > 0) {
+		if (domain == Domain::EMT)
+			multiply_connected<EMT::SimNode, EMT::Ph3::Resistor, EMT::Ph3::Inductor, EMT::Ph3::Capacitor>(sys, grid.copies,
+				Math::singlePhaseParameterToThreePhase(12.5),
+				Math::singlePhaseParameterToThreePhase(0.16),
+				Math::singlePhaseParameterToThreePhase(1e-6));
+		else
+			multiply_connected<DP::SimNode, DP::Ph1::Resistor, DP::Ph1::Inductor, DP::Ph1::Capacitor>(sys, grid.copies,
+				12.5, 0.16, 1e-6);
+	}
+
+	return sys;
+}
+
+std::shared_ptr<Scheduler> makeScheduler(const String& name, Int threads) {
+	if (name == "thread_level")
+		return std::make_shared<ThreadLevelScheduler>(threads);
+	if (name == "thread_list")
+		return std::make_shared<ThreadListScheduler>(threads);
+	if (name == "thread_heft")
+		return std::make_shared<ThreadHEFTScheduler>(threads);
+	if (name == "thread_pool")
+		return std::make_shared<ThreadPoolScheduler>(threads);
+#ifdef WITH_OPENMP
+	if (name == "openmp_level")
+		return std::make_shared<OpenMPLevelScheduler>(threads);
+#endif
+	return std::make_shared<SequentialScheduler>();
+}
+
+String domainName(Domain domain) {
+	switch (domain) {
+		case Domain::SP: return "SP";
+		case Domain::DP: return "DP";
+		default: return "EMT";
+	}
+}
+
+BenchResult runScenario(const Grid& grid, Domain domain, const String& schedulerName,
+	Int threads, Real timeStep, Real finalTime) {
+
+	BenchResult res;
+	res.grid = grid.name;
+	res.copies = grid.copies;
+	res.domain = domainName(domain);
+	res.scheduler = schedulerName;
+
+	if (std::find(grid.domains.begin(), grid.domains.end(), domain) == grid.domains.end()) {
+		res.skipped = "grid is not simulated in " + res.domain + " domain";
+		return res;
+	}
+
+	String simName = grid.name + "_" + std::to_string(grid.copies) + "_" + res.domain + "_" + schedulerName;
+	Logger::setLogDir("logs/dpsim-bench/" + simName);
+
+	try {
+		SystemTopology sys = loadSystem(grid, domain);
+		res.nodes = static_cast<UInt>(sys.mNodes.size());
+
+		// The logger is called after each step instead of being scheduled
+		// as a task so that its cost can be measured separately.
+		auto logger = DataLogger::make(simName);
+		for (auto node : sys.mNodes)
+			logger->addAttribute(node->name() + ".V", node->attribute("v"));
+
+		Simulation sim(simName, Logger::Level::off);
+		sim.setSystem(sys);
+		sim.setTimeStep(timeStep);
+		sim.setFinalTime(finalTime);
+		sim.setDomain(domain);
+		// The SP grids are solved as power flow like in their examples
+		sim.setSolverType(domain == Domain::SP ? Solver::Type::NRP : Solver::Type::MNA);
+		sim.setScheduler(makeScheduler(schedulerName, threads));
+
+		auto start = std::chrono::steady_clock::now();
+		sim.initialize();
+		std::chrono::duration<Real> initTime = std::chrono::steady_clock::now() - start;
+
+		for (auto solver : sim.solvers()) {
+			auto attrList = std::dynamic_pointer_cast<AttributeList>(solver);
+			if (attrList && attrList->attributes().count("factorization_time"))
+				res.factorization += attrList->attribute<Real>("factorization_time")->get();
+		}
+		// The factorization is reported separately
+		res.initialize = initTime.count() - res.factorization;
+
+		std::chrono::duration<Real> logTime(0);
+		while (sim.time() < sim.finalTime()) {
+			sim.step();
+
+			auto logStart = std::chrono::steady_clock::now();
+			logger->log(sim.time(), sim.timeStepCount());
+			logTime += std::chrono::steady_clock::now() - logStart;
+		}
+		sim.scheduler()->stop();
+		logger->close();
+
+		auto& stepTimes = sim.stepTimeStatistics();
+		res.steps = static_cast<Int>(stepTimes.count());
+		if (res.steps > 0) {
+			res.stepMean = std::chrono::duration<Real>(stepTimes.mean()).count();
+			res.stepP99 = std::chrono::duration<Real>(stepTimes.percentile(0.99)).count();
+			res.logging = logTime.count() / res.steps;
+		}
+	}
+	catch (std::exception& e) {
+		res.error = e.what();
+	}
+	catch (...) {
+		res.error = "unknown error";
+	}
+
+	return res;
+}
+
+String jsonEscape(const String& str) {
+	String escaped;
+	for (auto c : str) {
+		if (c == '"' || c == '\\') {
+			escaped += '\\';
+			escaped += c;
+		}
+		else if (static_cast<unsigned char>(c) < 0x20) {
+			char code[7];
+			std::snprintf(code, sizeof(code), "\\u%04x", static_cast<unsigned char>(c));
+			escaped += code;
+		}
+		else
+			escaped += c;
+	}
+	return escaped;
+}
+
+void printJson(std::ostream& out, const std::vector<BenchResult>& results, Real timeStep, Real finalTime) {
+	out << "{\n";
+	out << "  \"time_step\": " << timeStep << ",\n";
+	out << "  \"final_time\": " << finalTime << ",\n";
+	out << "  \"scenarios\": [";
+	for (std::size_t i = 0; i < results.size(); i++) {
+		auto& res = results[i];
+		out << (i == 0 ? "\n" : ",\n");
+		out << "    {\"grid\": \"" << res.grid << "\""
+			<< ", \"copies\": " << res.copies
+			<< ", \"domain\": \"" << res.domain << "\""
+			<< ", \"scheduler\": \"" << res.scheduler << "\""
+			<< ", \"nodes\": " << res.nodes
+			<< ", \"steps\": " << res.steps;
+		if (!res.skipped.empty()) {
+			out << ", \"skipped\": \"" << jsonEscape(res.skipped) << "\"}";
+			continue;
+		}
+		if (!res.error.empty()) {
+			out << ", \"error\": \"" << jsonEscape(res.error) << "\"}";
+			continue;
+		}
+		out << std::scientific
+			<< ", \"initialize\": " << res.initialize
+			<< ", \"factorization\": " << res.factorization
+			<< ", \"step_mean\": " << res.stepMean
+			<< ", \"step_p99\": " << res.stepP99
+			<< ", \"logging\": " << res.logging << "}"
+			<< std::defaultfloat;
+	}
+	out << "\n  ]\n}" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+	CommandLineArgs args(argc, argv, "dpsim-bench", 0.0001, 0.1);
+
+	Int maxCopies = args.options.find("copies") != args.options.end() ? Int(args.options["copies"]) : 8;
+	Int threads = args.options.find("threads") != args.options.end() ? Int(args.options["threads"]) : 4;
+
+	std::list<fs::path> wsccFiles = {
+		"WSCC-09_RX_DI.xml",
+		"WSCC-09_RX_EQ.xml",
+		"WSCC-09_RX_SV.xml",
+		"WSCC-09_RX_TP.xml"
+	};
+
+	// File names as in the examples of the single grids
+	std::vector<Grid> grids;
+	std::vector<std::pair<String, fs::path>> cases = {
+		{ "case9", "case9.xml" },
+		{ "case14", "case14Both.xml" },
+		{ "case145", "case145.xml" },
+		{ "case300", "case300.xml" }
+	};
+	for (auto& c : cases)
+		grids.push_back({ c.first, { c.second }, "build/_deps/cim-data-src/Matpower_cases", 50, 0, { Domain::SP } });
+	for (Int copies = 1; copies <= maxCopies; copies *= 2)
+		grids.push_back({ "WSCC_9bus_mult_coupled", wsccFiles, "build/_deps/cim-data-src/WSCC-09/WSCC-09_RX", 60, copies,
+			{ Domain::DP, Domain::EMT } });
+
+	std::vector<String> schedulers = { "sequential", "thread_level", "thread_list", "thread_heft", "thread_pool" };
+#ifdef WITH_OPENMP
+	schedulers.push_back("openmp_level");
+#endif
+
+	std::vector<BenchResult> results;
+	for (auto& grid : grids) {
+		for (auto domain : { Domain::SP, Domain::DP, Domain::EMT }) {
+			for (auto& scheduler : schedulers) {
+				results.push_back(runScenario(grid, domain, scheduler,
+					threads, args.timeStep, args.duration));
+			}
+		}
+	}
+
+	printJson(std::cout, results, args.timeStep, args.duration);
+
+	return 0;
+}
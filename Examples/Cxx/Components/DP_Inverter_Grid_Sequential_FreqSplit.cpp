@@ -89,6 +89,7 @@ int main(int argc, char* argv[]) {
 	sim.setFinalTime(finalTime);
 	sim.doFrequencyParallelization(true);
 
+	sim.doStepTimeRecording();
 	sim.run();
 	sim.logStepTimes(simName + "_step_times");
 }
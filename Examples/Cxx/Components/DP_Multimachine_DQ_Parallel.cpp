@@ -118,6 +118,7 @@ void doSim(int threads, int generators, int repNumber) {
 		sim.setScheduler(sched);
 	}
 
+	sim.doStepTimeRecording();
 	sim.run();
 	sim.logStepTimes(name + "_step_times");
 }
@@ -64,6 +64,7 @@ int main(int argc, char* argv[]) {
 		Domain::DP, Solver::Type::MNA, Logger::Level::info);
 
 	sim.addLogger(logger);
+	sim.doVectorLogging();
 	sim.run();
 
 	return 0;
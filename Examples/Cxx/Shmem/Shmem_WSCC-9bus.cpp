@@ -55,6 +55,7 @@ int main(int argc, char *argv[]) {
 	}
 
 	sim.addInterface(&intf);
+	sim.doVectorLogging();
 	sim.run();
 
 	return 0;
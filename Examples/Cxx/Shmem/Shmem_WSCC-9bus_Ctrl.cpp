@@ -114,6 +114,7 @@ int main(int argc, char *argv[]) {
 
 	sim.addInterface(&intf, false);
 	sim.addLogger(logger);
+	sim.doVectorLogging();
 	sim.run(args.startTime);
 
 	return 0;
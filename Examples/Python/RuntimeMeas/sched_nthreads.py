@@ -30,6 +30,8 @@ if __name__ == '__main__':
         'thread_level meas',
         'thread_list',
         'thread_list meas',
+        'thread_heft meas',
+        'thread_pool',
     ]
     size = 1
     #size = 20
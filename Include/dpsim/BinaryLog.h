@@ -0,0 +1,97 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <iostream>
+#include <vector>
+#include <experimental/filesystem>
+namespace fs = std::experimental::filesystem;
+
+#include <dpsim/Config.h>
+#include <dpsim/Definitions.h>
+
+namespace DPsim {
+	/// Binary columnar format written by DataLogger. All numbers are stored
+	/// in the byte order of the writing machine.
+	///
+	/// The header consists of the magic string "DPSIMLOG", the uint32 fields
+	/// version, number of columns, maximum number of rows per block and size
+	/// of the header in bytes, followed by a descriptor per column (uint8 type,
+	/// uint8 reserved, uint16 length of the name, name without terminating
+	/// zero). The header is padded with zeros to a multiple of 8 bytes.
+	///
+	/// The data follows in blocks. Each block starts with the number of rows
+	/// as uint64, followed by the values of each column of these rows as
+	/// doubles, one column after the other. The first column is the time.
+	namespace BinaryLog {
+		static const char magic[8] = { 'D', 'P', 'S', 'I', 'M', 'L', 'O', 'G' };
+		static const std::uint32_t version = 1;
+
+		enum class ColumnType : std::uint8_t {
+			Real = 0,
+			/// Integer values stored as double
+			Int = 1,
+			/// Values that cannot be represented as number are stored as NaN
+			Other = 2
+		};
+	}
+
+	/// Reads files in the binary DataLogger format. The file is mapped into
+	/// memory, so the values of the blocks are accessed without parsing.
+	class BinaryLogReader {
+	public:
+		/// Maps the file and reads the header and the block index. Throws
+		/// std::runtime_error if the file is not in the binary format.
+		/// Incomplete blocks at the end of the file are ignored.
+		BinaryLogReader(const fs::path& filename);
+		~BinaryLogReader();
+
+		BinaryLogReader(const BinaryLogReader&) = delete;
+		BinaryLogReader& operator=(const BinaryLogReader&) = delete;
+
+		/// Names of the columns, the first column is the time
+		const std::vector<String>& columnNames() const { return mNames; }
+		const std::vector<BinaryLog::ColumnType>& columnTypes() const { return mTypes; }
+		/// Index of the column with the given name. Throws std::out_of_range
+		/// if there is no such column.
+		std::size_t columnIndex(const String& name) const;
+		/// Total number of rows of all blocks
+		std::size_t rows() const { return mRows; }
+
+		std::size_t blocks() const { return mBlocks.size(); }
+		std::size_t blockRows(std::size_t block) const { return mBlocks[block].rows; }
+		/// Values of a column in a block, pointing into the mapped file
+		const Real* blockColumn(std::size_t block, std::size_t column) const;
+
+		/// Copies the values of a column of all blocks
+		std::vector<Real> column(std::size_t column) const;
+		std::vector<Real> column(const String& name) const { return column(columnIndex(name)); }
+
+		/// Writes the values in the CSV format of DataLogger
+		void writeCSV(std::ostream& out) const;
+
+	private:
+		struct Block {
+			/// Offset of the first value in the file
+			std::size_t offset;
+			std::size_t rows;
+		};
+
+		const char* mData = nullptr;
+		std::size_t mSize = 0;
+		/// File content if the file cannot be mapped
+		std::vector<char> mBuffer;
+
+		std::vector<String> mNames;
+		std::vector<BinaryLog::ColumnType> mTypes;
+		std::vector<Block> mBlocks;
+		std::size_t mRows = 0;
+	};
+}
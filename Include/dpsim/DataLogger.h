@@ -8,42 +8,231 @@
 
 #pragma once
 
+#include <atomic>
 #include <map>
 #include <iostream>
 #include <fstream>
+#include <thread>
 #include <experimental/filesystem>
 namespace fs = std::experimental::filesystem;
 
+#include <dpsim/BinaryLog.h>
 #include <dpsim/Definitions.h>
 #include <dpsim/Scheduler.h>
 #include <cps/PtrFactory.h>
 #include <cps/Attribute.h>
+#include <cps/AttributeList.h>
 #include <cps/SimNode.h>
 #include <cps/Task.h>
 
 namespace DPsim {
 
-	class DataLogger : public SharedFactory<DataLogger> {
+	class DataLogger : public SharedFactory<DataLogger>, public CPS::AttributeList {
+
+	public:
+		/// Output formats of the logger
+		enum class Format {
+			/// Human-readable text file with the extension .csv
+			CSV,
+			/// Binary columnar file with the extension .bin, see BinaryLog
+			Binary
+		};
+
+		/// Behaviour of the asynchronous mode if the writer thread falls
+		/// behind and the ring buffer is full
+		enum class OverflowPolicy {
+			/// The simulation waits for the writer thread
+			Block,
+			/// The values of the step are discarded
+			Drop
+		};
+
+		/// Statistics that are computed over each window of downsampling
+		/// steps instead of logging only the first step of the window
+		enum Aggregation : UInt {
+			AggregateMin = 1,
+			AggregateMax = 2,
+			AggregateMean = 4,
+			AggregateRMS = 8,
+			/// The real and imaginary part of complex values are combined
+			/// to their magnitude, which is aggregated with the other
+			/// statistics, and the phase of their mean
+			AggregatePhasor = 16
+		};
+
+		class Step;
 
 	protected:
 		std::ofstream mLogFile;
 		String mName;
 		Bool mEnabled;
 		UInt mDownsampling;
+		Format mFormat;
 		fs::path mFilename;
 
 		std::map<String, CPS::AttributeBase::Ptr> mAttributes;
 
-		void logDataLine(Real time, Real data);
-		void logDataLine(Real time, const Matrix& data);
-		void logDataLine(Real time, const MatrixComp& data);
+		/// Attribute storing the value of a column that was added as part
+		/// of a complex or matrix attribute
+		struct Source {
+			CPS::AttributeBase::Ptr attr;
+			UInt row;
+			UInt col;
+			Bool imag;
+		};
+		std::map<String, Source> mSources;
+
+		/// Logged value with its source resolved before the first row is
+		/// written. Values stored in attributes are read directly, only
+		/// computed values go through the getter of the attribute.
+		struct Column {
+			enum class Kind {
+				/// Stored Real, also a part of a stored Complex
+				Real,
+				Int,
+				/// Entry of a stored Matrix
+				RealMatrix,
+				/// Part of an entry of a stored MatrixComp
+				CompMatrix,
+				RealGetter,
+				IntGetter,
+				/// Neither Real nor Int, logged as string
+				Other
+			};
+			Kind kind = Kind::Other;
+			const Real* real = nullptr;
+			const Int* integer = nullptr;
+			const Matrix* matrix = nullptr;
+			const MatrixComp* matrixComp = nullptr;
+			Int row = 0;
+			Int col = 0;
+			Bool imag = false;
+			CPS::Attribute<Real>::Ptr realGetter;
+			CPS::Attribute<Int>::Ptr intGetter;
+			CPS::AttributeBase::Ptr other;
+		};
+		/// Columns in the order of mAttributes
+		std::vector<Column> mColumns;
+		Bool mColumnsResolved = false;
+		Bool mHasOtherColumns = false;
+		/// Names and types of the written columns without the time
+		std::vector<String> mOutputNames;
+		std::vector<BinaryLog::ColumnType> mOutputTypes;
+		/// Current row for log and the last finished window
+		Real mRowTime = 0;
+		std::vector<Real> mRowValues;
+		std::vector<String> mRowStrings;
+
+		/// Combination of Aggregation flags, zero to log single steps
+		UInt mAggregation = 0;
+		/// Statistics written per aggregated value
+		UInt mStatistics = 0;
+		/// Value aggregated over the window, either a column or the
+		/// magnitude of the real and imaginary part of a phasor
+		struct Channel {
+			UInt column;
+			/// Column of the imaginary part of a phasor, otherwise -1
+			Int imag;
+			/// Index of the first written column
+			UInt output;
+			Bool integer;
+			Bool other;
+			Real min;
+			Real max;
+			Real sum;
+			Real sumSquares;
+			Real sumReal;
+			Real sumImag;
+		};
+		std::vector<Channel> mChannels;
+		/// Number of steps in the current window
+		UInt mWindowSamples = 0;
+		Real mWindowTime = 0;
+		/// Values of the current step if aggregating
+		std::vector<Real> mSampleValues;
+
+		/// Number of columns of the binary format including the time,
+		/// zero if the header has not been written yet
+		UInt mBinaryColumns = 0;
+		/// Maximum number of rows of a block of the binary format
+		UInt mBlockRows = 0;
+		/// Number of rows in mBlock
+		UInt mBlockFill = 0;
+		/// Rows of the current block of the binary format, column major
+		std::vector<Real> mBlock;
+		/// Values of a row of the binary format without the time
+		std::vector<Real> mBinaryRow;
+
+		/// Number of rows of the ring buffer of the asynchronous mode,
+		/// which is disabled if zero
+		UInt mAsyncBufferSize = 0;
+		OverflowPolicy mOverflowPolicy = OverflowPolicy::Block;
+		/// Takes the snapshots into and writes them from the ring buffer
+		std::shared_ptr<Step> mAsyncStep;
+		std::thread mAsyncWriter;
+		/// Number of rows put into the ring buffer by the simulation
+		std::atomic<std::uint64_t> mAsyncHead;
+		/// Number of rows written by the writer thread
+		std::atomic<std::uint64_t> mAsyncTail;
+		/// Changed to wake up the parked writer thread
+		std::atomic<Int> mAsyncSignal;
+		std::atomic<Bool> mAsyncWaiting;
+		/// Changed to wake up the simulation thread parked on a full buffer
+		std::atomic<Int> mAsyncFreeSignal;
+		std::atomic<Bool> mAsyncBlocked;
+		std::atomic<Bool> mAsyncStopping;
+		/// Number of steps that found the ring buffer full
+		std::atomic<std::uint64_t> mAsyncOverflows;
+
+		/// Writes the column names if nothing has been written yet
+		void logHeader();
+
+		/// Writes the header of the binary format and allocates the block
+		void writeBinaryHeader(const std::vector<String>& names,
+			const std::vector<BinaryLog::ColumnType>& types);
+		/// Appends a row to the current block of the binary format
+		void logBinaryRow(Real time, const std::vector<Real>& values);
+		/// Writes the rows of the current block
+		void flushBinaryBlock();
+
+		void initAttributes();
+
+		void addColumn(const String &name, CPS::AttributeBase::Ptr attr);
+		void addColumn(const String &name, CPS::AttributeBase::Ptr attr, const Source &source);
+		/// Resolves the sources of the columns if not done yet
+		void resolveColumns();
+		/// Copies the values of all columns, NaN for columns of kind Other
+		void readValues(Real* values) const;
+		/// Determines the written columns and the aggregated values
+		void resolveOutputs();
+		/// Writes a row in the CSV format, the strings are only used for
+		/// columns of type Other
+		void logCSVRow(Real time, const std::vector<Real>& values, const std::vector<String>& strings);
+		/// Writes the header if needed and the row in the format of the logger
+		void logRow(Real time, const std::vector<Real>& values, const std::vector<String>& strings);
+
+		/// Returns true if a row is written for the step. If aggregating,
+		/// the values of the step are added to the window and the row is
+		/// the finished window.
+		Bool takesRow(Real time, Int timeStepCount);
+		/// Copies the row taken for the step
+		void readRow(Real time, Real& rowTime, std::vector<Real>& values, std::vector<String>& strings);
+		void aggregate(Real time);
+		/// Computes the statistics of the window into mRowValues
+		void finishWindow();
+		/// Puts the row taken for the step into the ring buffer
+		void logAsync(Real time);
+		/// Writes the remaining rows and stops the writer thread
+		void stopAsync();
+		void asyncWriterFunction();
 
 	public:
 		typedef std::shared_ptr<DataLogger> Ptr;
 		typedef std::vector<DataLogger::Ptr> List;
 
 		DataLogger(Bool enabled = true);
-		DataLogger(String name, Bool enabled = true, UInt downsampling = 1);
+		DataLogger(String name, Bool enabled = true, UInt downsampling = 1, Format format = Format::CSV);
+		~DataLogger() { close(); }
 
 		void open();
 		void close();
@@ -55,6 +244,12 @@ namespace DPsim {
 		void logPhasorNodeValues(Real time, const Matrix& data, Int freqNum = 1);
 		void logEMTNodeValues(Real time, const Matrix& data);
 
+		/// Writes the values as row. The column names are given by
+		/// setColumnNames before the first row.
+		void logDataLine(Real time, Real data);
+		void logDataLine(Real time, const Matrix& data);
+		void logDataLine(Real time, const MatrixComp& data);
+
 		void setColumnNames(std::vector<String> names);
 
 		void addAttribute(const String &name, CPS::AttributeBase::Ptr attr);
@@ -74,12 +269,39 @@ namespace DPsim {
 
 		void log(Real time, Int timeStepCount);
 
+		/// Aggregates the values over windows of downsampling steps instead
+		/// of dropping the steps in between. The aggregation is a combination
+		/// of Aggregation flags and writes a column per value and statistic,
+		/// with the suffixes .min, .max, .mean and .rms. The mean is used if
+		/// no statistic is given. Rows are stamped with the time of the first
+		/// step of the window, an incomplete window is written by close.
+		/// Must be called before the first step.
+		void setAggregation(UInt aggregation) {
+			mAggregation = aggregation;
+			mColumnsResolved = false;
+		}
+
+		/// Enables the asynchronous mode, in which log only copies the values
+		/// into a ring buffer with the given number of rows and a separate
+		/// thread writes them to the file. The attributes "overflows" and
+		/// "lag" count the steps that found the buffer full and the rows not
+		/// written yet. Must be called before the first step.
+		void setAsync(UInt bufferSize = 1024, OverflowPolicy policy = OverflowPolicy::Block) {
+			mAsyncBufferSize = bufferSize;
+			mOverflowPolicy = policy;
+		}
+
+		/// Resolves the columns and starts the writer thread of the
+		/// asynchronous mode. Called by the simulation after its
+		/// initialization, otherwise done in the first logged step.
+		void start();
+
 		CPS::Task::Ptr getTask();
 
-		class Step : public CPS::Task {
+		class Step : public PipelinedTask {
 		public:
 			Step(DataLogger& logger) :
-				Task(logger.mName + ".Write"), mLogger(logger) {
+				PipelinedTask(logger.mName + ".Write"), mLogger(logger) {
 				for (auto attr : logger.mAttributes) {
 					mAttributeDependencies.push_back(attr.second);
 				}
@@ -88,8 +310,22 @@ namespace DPsim {
 
 			void execute(Real time, Int timeStepCount);
 
+			void setBufferSize(UInt size);
+			void snapshot(Real time, Int timeStepCount, UInt slot);
+			void process(UInt slot);
+			/// Copies the row taken for the step into the slot
+			void copyRow(Real time, UInt slot);
+
 		private:
 			DataLogger& mLogger;
+
+			struct Snapshot {
+				Bool valid = false;
+				Real time = 0;
+				std::vector<Real> values;
+				std::vector<String> strings;
+			};
+			std::vector<Snapshot> mSnapshots;
 		};
 	};
 }
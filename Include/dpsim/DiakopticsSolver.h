@@ -38,7 +38,7 @@ namespace DPsim {
 			/// Factorization of the subnet's block
 			CPS::LUFactorized luFactorization;
 			/// List of all right side vector contributions
-			std::vector<const Matrix*> rightVectorStamps;
+			std::vector<const CPS::RightVectorStamp*> rightVectorStamps;
 			/// Left-side vector of the subnet AFTER complete step
 			CPS::Attribute<Matrix>::Ptr leftVector;
 		};
@@ -52,6 +52,9 @@ namespace DPsim {
 		std::shared_ptr<DataLogger> mLeftVectorLog;
 		/// Right side vector logger
 		std::shared_ptr<DataLogger> mRightVectorLog;
+		/// Logged entries of the left and right side vector of the current step
+		Matrix mLeftVectorValues;
+		Matrix mRightVectorValues;
 
 		std::vector<Subnet> mSubnets;
 		std::unordered_map<typename CPS::SimNode<VarType>::Ptr, Subnet*> mNodeSubnetMap;
@@ -87,7 +90,12 @@ namespace DPsim {
 		void assignMatrixNodeIndices(int net);
 		void setSubnetSize(int net, UInt nodes);
 
-		void setLogColumns();
+		/// Determines the logged vector entries and creates the loggers
+		void initializeVectorLogging();
+		/// Returns true if the vector entries of the step are logged
+		Bool isVectorLogStep(Int timeStepCount) {
+			return mVectorLogDownsampling > 0 && timeStepCount % mVectorLogDownsampling == 0;
+		}
 
 		void createMatrices();
 		void createTearMatrices(UInt totalSize);
@@ -97,7 +105,10 @@ namespace DPsim {
 		void initMatrices();
 		void applyTearComponentStamp(UInt compIdx);
 
-		void log(Real time);
+		/// Logs the selected entries of the left and right vector
+		void log(Real time, Int timeStepCount);
+		/// Logs the given entries of the left and right vector
+		void logVectors(Real time, const Matrix& leftValues, const Matrix& rightValues);
 
 	public:
 		DiakopticsSolver(String name, CPS::SystemTopology system, CPS::IdentifiedObject::List tearComponents, Real timeStep, CPS::Logger::Level logLevel);
@@ -109,7 +120,7 @@ namespace DPsim {
 			SubnetSolveTask(DiakopticsSolver<VarType>& solver, UInt net) :
 				Task(solver.mName + ".SubnetSolve_" + std::to_string(net)), mSolver(solver), mSubnet(solver.mSubnets[net]) {
 				for (auto it : mSubnet.components) {
-					if (it->template attribute<Matrix>("right_vector")->get().size() != 0) {
+					if (it->template attribute<CPS::RightVectorStamp>("right_vector")->get().size() != 0) {
 						mAttributeDependencies.push_back(it->attribute("right_vector"));
 					}
 				}
@@ -169,10 +180,10 @@ namespace DPsim {
 			DiakopticsSolver<VarType>& mSolver;
 		};
 
-		class LogTask : public CPS::Task {
+		class LogTask : public PipelinedTask {
 		public:
 			LogTask(DiakopticsSolver<VarType>& solver) :
-				Task(solver.mName + ".Log"), mSolver(solver) {
+				PipelinedTask(solver.mName + ".Log"), mSolver(solver) {
 				for (auto& net : solver.mSubnets) {
 					mAttributeDependencies.push_back(net.leftVector);
 				}
@@ -181,8 +192,16 @@ namespace DPsim {
 
 			void execute(Real time, Int timeStepCount);
 
+			void setBufferSize(UInt size);
+			void snapshot(Real time, Int timeStepCount, UInt slot);
+			void process(UInt slot);
+
 		private:
 			DiakopticsSolver<VarType>& mSolver;
+			std::vector<Bool> mLogged;
+			std::vector<Real> mTimes;
+			std::vector<Matrix> mLeftVectors;
+			std::vector<Matrix> mRightVectors;
 		};
 	};
 }
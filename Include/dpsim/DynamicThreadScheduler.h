@@ -0,0 +1,72 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <dpsim/Scheduler.h>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace DPsim {
+	/// Base class of the schedulers that assign the tasks to threads at
+	/// runtime. Tasks become ready when all of their predecessors have been
+	/// executed. The thread executing the last predecessor of a task pushes it
+	/// to the ready tasks, so that no central thread is involved in the
+	/// scheduling. The calling thread takes part in executing the tasks.
+	/// Derived classes only provide the container of the ready tasks.
+	class DynamicThreadScheduler : public Scheduler {
+	public:
+		DynamicThreadScheduler(Int threads, String outMeasurementFile);
+		virtual ~DynamicThreadScheduler();
+
+		void createSchedule(const CPS::Task::List& tasks, const Edges& inEdges, const Edges& outEdges);
+		void step(Real time, Int timeStepCount);
+		void stop();
+
+		/// Sets how the threads wait for the start and the end of a step.
+		/// Must be called before the schedule is created.
+		void setWaitMode(WaitMode mode) {
+			mStartBarrier.setWaitMode(mode);
+			mEndBarrier.setWaitMode(mode);
+		}
+
+	protected:
+		/// Allocates the ready task container for the tasks of mGraph
+		virtual void initReadyTasks() = 0;
+		/// Adds a ready task, called by the given thread. Tasks without
+		/// predecessors are distributed over all threads at the start of a step.
+		virtual void pushReadyTask(Int thread, Int task) = 0;
+		/// Takes a ready task for the given thread, returns false if there is none
+		virtual Bool popReadyTask(Int thread, Int& task) = 0;
+
+		Int mNumThreads;
+		/// Compiled dependency graph of the tasks
+		TaskGraph mGraph;
+
+	private:
+		void doStep(Int thread);
+		static void threadFunction(DynamicThreadScheduler* sched, Int idx);
+
+		String mOutMeasurementFile;
+		Barrier mStartBarrier;
+		Barrier mEndBarrier;
+		std::vector<std::thread> mThreads;
+
+		/// Number of predecessors of each task not executed yet in the current step
+		std::unique_ptr<std::atomic<Int>[]> mPendingInDegrees;
+		/// Number of tasks not executed yet in the current step
+		std::atomic<Int> mPendingTasks;
+
+		Bool mJoining = false;
+		Real mTime = 0;
+		Int mTimeStepCount = 0;
+	};
+}
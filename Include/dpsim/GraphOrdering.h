@@ -0,0 +1,110 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <set>
+#include <vector>
+
+#include <dpsim/Definitions.h>
+
+namespace DPsim {
+namespace GraphOrdering {
+	/// Undirected graph given by the adjacency set of each vertex
+	using Graph = std::vector<std::set<UInt>>;
+
+	/// Returns the vertices in reverse Cuthill-McKee order,
+	/// which reduces the bandwidth of the matrix
+	std::vector<UInt> reverseCuthillMcKee(const Graph& graph);
+
+	/// Column orderings of the sparse LU factorization:
+	/// COLAMD (the default of Eigen), reverse Cuthill-McKee and
+	/// approximate minimum degree
+	enum class Method { COLAMD, RCM, MinimumDegree };
+
+	/// Computes the column ordering of the given method. RCM and minimum
+	/// degree are computed for the symmetric pattern of A + A^T.
+	template <typename StorageIndex>
+	class Ordering {
+	public:
+		typedef Eigen::PermutationMatrix<Eigen::Dynamic, Eigen::Dynamic, StorageIndex> PermutationType;
+
+		Ordering(Method method) : mMethod(method) { }
+
+		template <typename MatrixType>
+		void operator()(const MatrixType& mat, PermutationType& perm) const {
+			if (mMethod == Method::COLAMD) {
+				Eigen::COLAMDOrdering<StorageIndex>()(mat, perm);
+				return;
+			}
+			if (mMethod == Method::MinimumDegree) {
+				Eigen::AMDOrdering<StorageIndex>()(mat, perm);
+				return;
+			}
+
+			Graph graph(mat.cols());
+			for (Eigen::Index outer = 0; outer < mat.outerSize(); outer++) {
+				for (typename MatrixType::InnerIterator it(mat, outer); it; ++it) {
+					if (it.row() == it.col())
+						continue;
+					graph[it.row()].insert(static_cast<UInt>(it.col()));
+					graph[it.col()].insert(static_cast<UInt>(it.row()));
+				}
+			}
+
+			std::vector<UInt> order = reverseCuthillMcKee(graph);
+
+			// The permutation maps each column to its position in the order
+			perm.resize(mat.cols());
+			for (UInt pos = 0; pos < order.size(); pos++)
+				perm.indices()(order[pos]) = static_cast<StorageIndex>(pos);
+		}
+
+	private:
+		Method mMethod;
+	};
+
+	/// Ordering type of Eigen::SparseLU that keeps the column permutation
+	/// set by SparseLU before the analysis
+	template <typename StorageIndex>
+	class PresetOrdering {
+	public:
+		typedef Eigen::PermutationMatrix<Eigen::Dynamic, Eigen::Dynamic, StorageIndex> PermutationType;
+
+		template <typename MatrixType>
+		void operator()(const MatrixType& mat, PermutationType& perm) { }
+	};
+
+	/// Sparse LU factorization with a column ordering chosen per analysis.
+	/// The analysis and compute methods of Eigen::SparseLU are hidden,
+	/// so the ordering method has to be passed explicitly.
+	template <typename MatrixType>
+	class SparseLU : public Eigen::SparseLU<MatrixType,
+		PresetOrdering<typename MatrixType::StorageIndex>> {
+	public:
+		typedef Eigen::SparseLU<MatrixType, PresetOrdering<typename MatrixType::StorageIndex>> Base;
+
+		void analyzePattern(const MatrixType& mat, Method method) {
+			// Compute the ordering of the compressed copy as Eigen does
+			Ordering<typename MatrixType::StorageIndex> ordering(method);
+			this->m_mat = mat;
+			ordering(this->m_mat, this->m_perm_c);
+			Base::analyzePattern(mat);
+		}
+
+		void compute(const MatrixType& mat, Method method) {
+			analyzePattern(mat, method);
+			Base::factorize(mat);
+		}
+	};
+}
+
+	/// Sparse LU factorizations with the column ordering selected at the analysis
+	typedef GraphOrdering::SparseLU<CPS::SparseMatrix> OrderedSparseLU;
+	typedef GraphOrdering::SparseLU<CPS::SparseMatrixComp> OrderedSparseLUComp;
+}
@@ -83,10 +83,12 @@ namespace DPsim {
 			InterfaceShmem& mIntf;
 		};
 
-		class PostStep : public CPS::Task {
+		/// Writes the exported values. When pipelined, the step only fills a
+		/// sample, which is written to the queue by the pipeline thread.
+		class PostStep : public PipelinedTask {
 		public:
 			PostStep(InterfaceShmem& intf) :
-				Task(intf.mWName + ".Write"), mIntf(intf) {
+				PipelinedTask(intf.mWName + ".Write"), mIntf(intf) {
 				for (auto attr : intf.mExportAttrs) {
 					mAttributeDependencies.push_back(attr);
 				}
@@ -95,8 +97,14 @@ namespace DPsim {
 
 			void execute(Real time, Int timeStepCount);
 
+			void setBufferSize(UInt size);
+			void snapshot(Real time, Int timeStepCount, UInt slot);
+			void process(UInt slot);
+
 		private:
 			InterfaceShmem& mIntf;
+			/// Filled samples of the buffered steps, nullptr if the step is not exported
+			std::vector<Sample*> mSamples;
 		};
 
 		/** Create a InterfaceShmem with a specific configuration for the output queue.
@@ -151,6 +159,12 @@ namespace DPsim {
 		 */
 		void writeValues();
 
+		/// Allocates a sample and fills it with the exported values.
+		/// Returns the last written sample if the values cannot be exported.
+		Sample* prepareSample();
+		/// Writes a sample returned by prepareSample to the queue
+		void writeSample(Sample* sample);
+
 		CPS::Task::List getTasks();
 	};
 }
@@ -0,0 +1,74 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <vector>
+
+#include <dpsim/Definitions.h>
+#include <dpsim/GraphOrdering.h>
+#include <dpsim/Scheduler.h>
+
+namespace DPsim {
+	/// Forward and backward substitution with the factors of a sparse LU
+	/// decomposition that can be executed by several threads at once.
+	/// The rows of each triangular factor are grouped into levels such that
+	/// the rows of one level only depend on rows of previous levels and can
+	/// be computed in parallel.
+	class LevelScheduledLU {
+	public:
+		/// Minimum number of rows per thread for a level to be computed in
+		/// parallel. Smaller levels are computed by the first thread.
+		static const Int mMinRowsPerThread = 16;
+
+		/// Computes the triangular factors of the system matrix with the
+		/// permutations of its decomposition and the levels of their rows
+		void analyze(const OrderedSparseLU& lu, const SparseMatrix& systemMatrix, Int numThreads = 1);
+
+		/// Permutes the right side vector and stores it as work vector.
+		/// Must be called by a single thread before solveThread.
+		void prepare(const Matrix& rightSideVector);
+		/// Computes the share of the substitution of the given thread.
+		/// Must be called concurrently by all threads passed to analyze,
+		/// which are synchronized with the barrier.
+		void solveThread(Int thread, Barrier& barrier);
+		/// Permutes the work vector back and stores it as solution.
+		/// Must be called by a single thread after solveThread.
+		void finish(Matrix& leftSideVector);
+
+	private:
+		/// Consecutive rows in level order that are either computed
+		/// in parallel or by the first thread only
+		struct Segment {
+			Int begin;
+			Int end;
+			Bool parallel;
+		};
+
+		/// Sorts the rows by level and groups the levels into segments
+		void computeSegments(const std::vector<Int>& rowLevels, Int numLevels,
+			std::vector<Int>& rows, std::vector<Segment>& segments);
+
+		/// Number of threads executing the substitution
+		Int mNumThreads = 1;
+		/// Strictly lower triangular factor with implicit unit diagonal
+		CPS::SparseMatrixRow mLower;
+		/// Strictly upper triangular factor
+		CPS::SparseMatrixRow mUpper;
+		/// Diagonal of the upper triangular factor
+		Matrix mUpperDiagonal;
+		/// Row and column permutations of the decomposition
+		OrderedSparseLU::PermutationType mRowPermutation, mColPermutation;
+		/// Rows of the factors in level order
+		std::vector<Int> mLowerRows, mUpperRows;
+		/// Segments of the forward and backward substitution
+		std::vector<Segment> mLowerSegments, mUpperSegments;
+		/// Intermediate and final solution in permuted order
+		Matrix mWork;
+	};
+}
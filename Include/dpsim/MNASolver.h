@@ -17,6 +17,7 @@
 #include <dpsim/Config.h>
 #include <dpsim/Solver.h>
 #include <dpsim/DataLogger.h>
+#include <dpsim/LevelScheduledLU.h>
 #include <cps/AttributeList.h>
 #include <cps/Solver/MNASwitchInterface.h>
 #include <cps/Solver/MNAVariableCompInterface.h>
@@ -38,9 +39,15 @@
 #endif
 
 namespace DPsim {
+	template <typename VarType>
+	class MnaSolverEnsemble;
+
 	/// Solver class using Modified Nodal Analysis (MNA).
 	template <typename VarType>
 	class MnaSolver : public Solver, public CPS::AttributeList {
+		/// Solves several scenarios of the same topology with one factorization
+		friend class MnaSolverEnsemble<VarType>;
+
 	protected:
 		// #### General simulation settings ####
 		/// Simulation domain, which can be dynamic phasor (DP) or EMT
@@ -86,7 +93,7 @@ namespace DPsim {
 		Matrix mRightSideVector;
 		std::vector<Matrix> mRightSideVectorHarm;
 		/// List of all right side vector contributions
-		std::vector<const Matrix*> mRightVectorStamps;
+		std::vector<const CPS::RightVectorStamp*> mRightVectorStamps;
 		/// Solution vector of unknown quantities
 		Matrix mLeftSideVector;
 		std::vector<Matrix> mLeftSideVectorHarm;
@@ -99,11 +106,106 @@ namespace DPsim {
 		std::unordered_map< std::bitset<SWITCH_NUM>, std::vector<Matrix> > mSwitchedMatricesHarm;
 #ifdef WITH_SPARSE
 		/// Map of LU factorizations related to the system matrices
-		std::unordered_map< std::bitset<SWITCH_NUM>, CPS::LUFactorizedSparse > mLuFactorizations;
+		std::unordered_map< std::bitset<SWITCH_NUM>, OrderedSparseLU > mLuFactorizations;
 #else
 		std::unordered_map< std::bitset<SWITCH_NUM>, CPS::LUFactorized > mLuFactorizations;
 #endif
 		std::unordered_map< std::bitset<SWITCH_NUM>, std::vector<CPS::LUFactorized> > mLuFactorizationsHarm;
+		/// Wall clock time in seconds to assemble and factorize the system matrices
+		/// during initialization
+		Real mFactorizationTime = 0;
+		/// Determines if the system matrices are factorized by this solver.
+		/// Otherwise, the factorizations of another solver with the same
+		/// system matrices are used, as done by MnaSolverEnsemble.
+		Bool mFactorizeSystem = true;
+
+		// #### Attributes related to lazy switch factorization ####
+		/// Switch configurations in cache, most recently used first
+		std::list< std::bitset<SWITCH_NUM> > mSwitchCacheOrder;
+		/// Position of each cached switch configuration in mSwitchCacheOrder
+		std::unordered_map< std::bitset<SWITCH_NUM>,
+			std::list< std::bitset<SWITCH_NUM> >::iterator > mSwitchCacheEntries;
+		/// Switch configuration the cache was last updated for
+		std::bitset<SWITCH_NUM> mSwitchCacheStatus;
+		/// Number of switching events to a configuration found in cache
+		Int mSwitchCacheHits = 0;
+		/// Number of switch configurations that had to be factorized
+		Int mSwitchCacheMisses = 0;
+		/// Returns true if switch configurations are factorized on demand
+		Bool isSwitchCacheEnabled() {
+			return mSwitchCacheSize > 0 && mSwitches.size() > 0 && !mSwitchLowRankUpdate;
+		}
+		/// Makes sure that the current switch configuration is factorized.
+		/// Only called if the switch configuration has changed.
+		void updateSwitchCache();
+		/// Stamps and factorizes the system matrix of a switch configuration
+		/// starting from the base matrix with all static components
+		void factorizeSwitchConfiguration(std::bitset<SWITCH_NUM> status);
+		/// Stamps all static components into the base matrix
+		void stampBaseSystemMatrix();
+		/// Factorizes the stamped system matrix of a switch configuration,
+		/// either as complex or as split system
+		void factorizeSystemMatrix(std::bitset<SWITCH_NUM> status, CPS::Logger::Level level);
+
+		// #### Attributes related to low-rank switch updates ####
+		/// Switch configuration of the factorization used as base for updates
+		std::bitset<SWITCH_NUM> mLowRankBaseStatus;
+		/// Switch configuration the current low-rank correction was computed for
+		std::bitset<SWITCH_NUM> mLowRankUpdateStatus;
+		/// Change of the system matrix if a switch is closed instead of open
+		std::vector<SparseMatrix> mSwitchDeltaMatrices;
+		/// Matrix rows and columns changed with respect to the base configuration
+		std::vector<UInt> mLowRankRows, mLowRankCols;
+		/// Transposed right factor R of the changed entries D = L R^T of the
+		/// system matrix, whose inner dimension is the rank of the update
+		Matrix mLowRankDelta;
+		/// Solutions of the base system for the columns of the left factor L
+		/// scattered to the changed rows
+		Matrix mLowRankBaseSolutions;
+		/// Factorization of the capacitance matrix of the Woodbury identity
+		CPS::LUFactorized mLowRankCapacitance;
+		/// Returns true if switching is handled by low-rank updates
+		Bool isSwitchLowRankUpdateEnabled() { return mSwitchLowRankUpdate && mSwitches.size() > 0; }
+		/// Computes the low-rank correction for the current switch configuration
+		/// or refactorizes the system if the rank is too high
+		void updateLowRankCorrection();
+		/// Solves the system using the base factorization and the low-rank correction
+		void solveWithLowRankUpdate();
+
+		// #### Attributes related to the complex sparse solve ####
+		/// Factorizations of the complex system matrices, which have half the
+		/// dimension of the matrices split into real and imaginary parts
+		std::unordered_map< std::bitset<SWITCH_NUM>, OrderedSparseLUComp > mLuFactorizationsComp;
+		/// Complex source vector
+		MatrixComp mRightSideVectorComp;
+		/// Complex solution vector
+		MatrixComp mLeftSideVectorComp;
+		/// Returns true if the phasor system is solved as complex system
+		Bool isComplexSparseSolveEnabled();
+		/// Converts the split system matrix of a switch configuration to a complex
+		/// matrix and factorizes it instead of the split matrix. Returns false and
+		/// falls back to the split system for all switch configurations if the
+		/// matrix does not have the structure of a complex matrix.
+		Bool factorizeComplexSystem(std::bitset<SWITCH_NUM> status, CPS::Logger::Level level);
+		/// Solves the complex system and writes the solution to the split vector
+		void solveComplexSystem();
+
+		// #### Attributes related to the level-scheduled solve ####
+		/// Level-scheduled substitutions of the factorized switch configurations
+		std::unordered_map< std::bitset<SWITCH_NUM>, LevelScheduledLU > mLevelScheduledLUs;
+		/// Substitution of the switch configuration in the current step
+		LevelScheduledLU* mCurrentLevelScheduledLU = nullptr;
+		/// Number of threads executing the solve
+		Int mSolveThreads = 1;
+		/// Synchronizes the threads executing the solve
+		std::unique_ptr<Barrier> mSolveBarrier;
+		/// Returns true if the solve is executed by all scheduler threads
+		Bool isLevelScheduledSolveEnabled();
+		/// Sets the number of threads and how they wait for each other
+		/// and resets the level schedules
+		void setSolveThreads(Int numThreads, WaitMode waitMode = WaitMode::Spin);
+		/// Solves the system together with the other threads
+		void solveThread(Real time, Int timeStepCount, Int thread);
 
 		// #### Attributes related to switching ####
 		/// Index of the next switching event
@@ -120,15 +222,35 @@ namespace DPsim {
 		std::shared_ptr<DataLogger> mLeftVectorLog;
 		/// Right side vector logger
 		std::shared_ptr<DataLogger> mRightVectorLog;
+		/// Logged entries of the left and right side vector of the current step
+		Matrix mLeftVectorValues;
+		Matrix mRightVectorValues;
 
 		/// Initialization of individual components
 		void initializeComponents();
+		/// Registers the right side vector contribution of a component
+		void addRightVectorStamp(CPS::MNAInterface::Ptr comp);
+		/// Scatter-adds all right side vector contributions to the source vector
+		void addRightVectorStamps();
+		/// Stamps the right side vector contribution of a component outside
+		/// of its tasks and adds it to the source vector
+		void stampRightSideVector(CPS::MNAInterface::Ptr comp);
 		/// Initialization of system matrices and source vector
 		virtual void initializeSystem();
 		/// Initialization of system matrices and source vector
 		void initializeSystemWithParallelFrequencies();
 		/// Initialization of system matrices and source vector
 		void initializeSystemWithPrecomputedMatrices();
+		/// Initialization of base matrix and the matrix for the initial switch configuration
+		void initializeSystemWithSwitchCache();
+		/// Initialization of base factorization and switch changes for low-rank updates
+		void initializeSystemWithLowRankUpdates();
+		/// Initialization of source vector and switch status without system matrices
+		/// for solvers that use the factorizations of another solver
+		void initializeSystemWithSharedFactorization();
+		/// Stamps all components and switches into an empty system matrix
+		/// for the given switch configuration
+		void stampSystemMatrix(MAT_TYPE& systemMatrix, std::bitset<SWITCH_NUM> status);
 		/// Identify Nodes and SimPowerComps and SimSignalComps
 		void identifyTopologyObjects();
 		/// Assign simulation node index according to index in the vector.
@@ -142,6 +264,37 @@ namespace DPsim {
 		void createEmptyVectors();
 		/// Create system matrix
 		void createEmptySystemMatrix();
+#ifdef WITH_SPARSE
+		/// Number of entries per row reserved before stamping
+		static const Int mNumStampEntriesPerRow = 16;
+		/// Reserves space for the component stamps in an empty sparse system matrix
+		void reserveSystemMatrix(SparseMatrix& systemMatrix);
+#endif
+		/// Computes the symbolic analysis of a system matrix with the column
+		/// ordering selected by setNodeOrdering
+		template <typename LUType, typename MatrixType>
+		void analyzeSystemMatrix(LUType& lu, const MatrixType& systemMatrix) {
+			lu.analyzePattern(systemMatrix, mNodeOrdering);
+		}
+		/// Logs the number of non-zeros of the LU factors of a switch configuration.
+		/// For a node ordering other than COLAMD, the system matrix is factorized
+		/// once more with COLAMD to compare the fill-in of both orderings.
+		template <typename LUType, typename MatrixType>
+		void logFactorNonZeros(const LUType& lu, const MatrixType& systemMatrix,
+			std::bitset<SWITCH_NUM> status, CPS::Logger::Level level) {
+			if (mNodeOrdering == NodeOrdering::COLAMD || !mSLog->should_log(level)) {
+				mSLog->log(level, "Non-zeros of LU factors for switch configuration {:s}: L {:d}, U {:d}",
+					status.to_string(), lu.nnzL(), lu.nnzU());
+				return;
+			}
+
+			LUType reference;
+			reference.compute(systemMatrix, NodeOrdering::COLAMD);
+			mSLog->log(level, "Non-zeros of LU factors for switch configuration {:s}: "
+				"L {:d}, U {:d}, total {:d} (COLAMD: L {:d}, U {:d}, total {:d})",
+				status.to_string(), lu.nnzL(), lu.nnzU(), lu.nnzL() + lu.nnzU(),
+				reference.nnzL(), reference.nnzU(), reference.nnzL() + reference.nnzU());
+		}
 		/// Logging of system matrices and source vector
 		void logSystemMatrices();
 
@@ -150,8 +303,16 @@ namespace DPsim {
 		virtual void solve(Real time, Int timeStepCount);
 		/// Solves system for multiple frequencies
 		void solveWithHarmonics(Real time, Int timeStepCount, Int freqIdx);
-		/// Logs left and right vector
+		/// Logs the selected entries of the left and right vector
 		void log(Real time, Int timeStepCount);
+		/// Returns true if the vector entries of the step are logged
+		Bool isVectorLogStep(Int timeStepCount) {
+			return mVectorLogDownsampling > 0 && timeStepCount % mVectorLogDownsampling == 0;
+		}
+		/// Determines the logged vector entries and creates the loggers
+		void initializeVectorLogging();
+		/// Logs the given entries of the left and right vector
+		void logVectors(Real time, const Matrix& leftValues, const Matrix& rightValues);
 
 	public:
 		/// Constructor should not be called by users but by Simulation
@@ -187,7 +348,7 @@ namespace DPsim {
 				Task(solver.mName + ".Solve"), mSolver(solver) {
 
 				for (auto it : solver.mMNAComponents) {
-					if (it->template attribute<Matrix>("right_vector")->get().size() != 0)
+					if (it->template attribute<CPS::RightVectorStamp>("right_vector")->get().size() != 0)
 						mAttributeDependencies.push_back(it->attribute("right_vector"));
 				}
 				for (auto node : solver.mNodes) {
@@ -202,6 +363,31 @@ namespace DPsim {
 			MnaSolver<VarType>& mSolver;
 		};
 
+		///
+		class ParallelSolveTask : public ParallelTask {
+		public:
+			ParallelSolveTask(MnaSolver<VarType>& solver) :
+				ParallelTask(solver.mName + ".Solve"), mSolver(solver) {
+
+				for (auto it : solver.mMNAComponents) {
+					if (it->template attribute<CPS::RightVectorStamp>("right_vector")->get().size() != 0)
+						mAttributeDependencies.push_back(it->attribute("right_vector"));
+				}
+				for (auto node : solver.mNodes) {
+					mModifiedAttributes.push_back(node->attribute("v"));
+				}
+				mModifiedAttributes.push_back(solver.attribute("left_vector"));
+			}
+
+			void setNumThreads(Int numThreads, WaitMode waitMode) { mSolver.setSolveThreads(numThreads, waitMode); }
+			void executeThread(Real time, Int timeStepCount, Int thread) {
+				mSolver.solveThread(time, timeStepCount, thread);
+			}
+
+		private:
+			MnaSolver<VarType>& mSolver;
+		};
+
 		///
 		class SolveTaskHarm : public CPS::Task {
 		public:
@@ -209,7 +395,7 @@ namespace DPsim {
 				Task(solver.mName + ".Solve"), mSolver(solver), mFreqIdx(freqIdx) {
 
 				for (auto it : solver.mMNAComponents) {
-					if (it->template attribute<Matrix>("right_vector")->get().size() != 0)
+					if (it->template attribute<CPS::RightVectorStamp>("right_vector")->get().size() != 0)
 						mAttributeDependencies.push_back(it->attribute("right_vector"));
 				}
 				for (auto node : solver.mNodes) {
@@ -228,18 +414,41 @@ namespace DPsim {
 		};
 
 		///
-		class LogTask : public CPS::Task {
+		class LogTask : public PipelinedTask {
 		public:
 			LogTask(MnaSolver<VarType>& solver) :
-				Task(solver.mName + ".Log"), mSolver(solver) {
+				PipelinedTask(solver.mName + ".Log"), mSolver(solver) {
 				mAttributeDependencies.push_back(solver.attribute("left_vector"));
 				mModifiedAttributes.push_back(Scheduler::external);
 			}
 
 			void execute(Real time, Int timeStepCount) { mSolver.log(time, timeStepCount); }
 
+			void setBufferSize(UInt size) {
+				mLogged.assign(size, false);
+				mTimes.resize(size);
+				mLeftVectors.resize(size);
+				mRightVectors.resize(size);
+			}
+			void snapshot(Real time, Int timeStepCount, UInt slot) {
+				mLogged[slot] = mSolver.isVectorLogStep(timeStepCount);
+				if (!mLogged[slot])
+					return;
+				mTimes[slot] = time;
+				mSolver.gatherVectorLogRows(mSolver.leftSideVector(), mLeftVectors[slot]);
+				mSolver.gatherVectorLogRows(mSolver.rightSideVector(), mRightVectors[slot]);
+			}
+			void process(UInt slot) {
+				if (mLogged[slot])
+					mSolver.logVectors(mTimes[slot], mLeftVectors[slot], mRightVectors[slot]);
+			}
+
 		private:
 			MnaSolver<VarType>& mSolver;
+			std::vector<Bool> mLogged;
+			std::vector<Real> mTimes;
+			std::vector<Matrix> mLeftVectors;
+			std::vector<Matrix> mRightVectors;
 		};
 	};
 }
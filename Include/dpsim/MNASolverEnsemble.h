@@ -0,0 +1,84 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <dpsim/MNASolver.h>
+
+namespace DPsim {
+	/// Solver class using Modified Nodal Analysis (MNA) that advances several
+	/// scenarios of the same topology in lockstep. Each scenario has its own
+	/// components and states. The source vectors of all scenarios are solved
+	/// at once with the factorization of the first scenario.
+	template <typename VarType>
+	class MnaSolverEnsemble : public MnaSolver<VarType> {
+	protected:
+		/// Systems of the additional scenarios
+		std::vector<CPS::SystemTopology> mScenarioSystems;
+		/// Solvers holding the MNA state of the additional scenarios
+		std::vector<std::shared_ptr<MnaSolver<VarType>>> mScenarioSolvers;
+		/// All scenarios including this solver as first scenario
+		std::vector<MnaSolver<VarType>*> mScenarios;
+		/// Source vectors of all scenarios, one column per scenario
+		Matrix mRightSideVectors;
+		/// Solution vectors of all scenarios, one column per scenario
+		Matrix mLeftSideVectors;
+		/// Determines if all scenarios are initialized and solved together
+		Bool mEnsembleInitialized = false;
+
+		/// Throws if a scenario cannot be solved with the factorizations of
+		/// this solver because its switches or system matrices differ
+		void checkScenario(MnaSolver<VarType>& scenario, UInt scenarioIdx);
+		/// Solves all scenarios
+		virtual void solve(Real time, Int timeStepCount) override;
+
+	public:
+		///
+		MnaSolverEnsemble(String name,
+			CPS::Domain domain = CPS::Domain::DP,
+			CPS::Logger::Level logLevel = CPS::Logger::Level::info);
+		///
+		virtual ~MnaSolverEnsemble() { };
+
+		/// Set systems of the additional scenarios. They must have the same
+		/// system matrices and switches in the same order as the system of
+		/// the first scenario, only sources and states may differ.
+		void setScenarios(std::vector<CPS::SystemTopology> systems) { mScenarioSystems = systems; }
+		/// Initializes all scenarios
+		void initialize();
+		/// Number of scenarios including the first one
+		UInt scenarioNumber() { return (UInt) mScenarios.size(); }
+		///
+		virtual CPS::Task::List getTasks() override;
+
+		// #### MNA Solver Tasks ####
+		///
+		class SolveTask : public CPS::Task {
+		public:
+			SolveTask(MnaSolverEnsemble<VarType>& solver) :
+				Task(solver.mName + ".Solve"), mSolver(solver) {
+
+				for (auto scenario : solver.mScenarios) {
+					for (auto it : scenario->mMNAComponents) {
+						if (it->template attribute<CPS::RightVectorStamp>("right_vector")->get().size() != 0)
+							mAttributeDependencies.push_back(it->attribute("right_vector"));
+					}
+					for (auto node : scenario->mNodes) {
+						mModifiedAttributes.push_back(node->attribute("v"));
+					}
+					mModifiedAttributes.push_back(scenario->attribute("left_vector"));
+				}
+			}
+
+			void execute(Real time, Int timeStepCount) { mSolver.solve(time, timeStepCount); }
+
+		private:
+			MnaSolverEnsemble<VarType>& mSolver;
+		};
+	};
+}
@@ -29,6 +29,14 @@ namespace DPsim {
 		void updateVariableCompStatus();
 		/// Initialization of system matrices and source vector
 		void initializeSystemWithDynamicMatrix();
+#ifdef WITH_SPARSE
+		/// Sparsity pattern the symbolic LU analysis was computed for
+		std::vector<SparseMatrix::StorageIndex> mAnalyzedOuterIndices, mAnalyzedInnerIndices;
+		/// Computes the symbolic analysis and saves the analyzed sparsity pattern
+		void analyzeSystemMatrixPattern();
+		/// Returns true if the current system matrix has the analyzed sparsity pattern
+		Bool hasAnalyzedPattern();
+#endif
 
 	public:
 		///
@@ -37,6 +45,9 @@ namespace DPsim {
 			CPS::Logger::Level logLevel = CPS::Logger::Level::info);
 		///
 		virtual ~MnaSolverSysRecomp() { };
+		/// Disables the switch cache, which is not supported by the
+		/// recomputation, and initializes the solver
+		virtual void initialize() override;
 		///
 		virtual CPS::Task::List getTasks() override;
 
@@ -48,7 +59,7 @@ namespace DPsim {
 				Task(solver.mName + ".Solve"), mSolver(solver) {
 
 				for (auto it : solver.mMNAComponents) {
-					if (it->template attribute<Matrix>("right_vector")->get().size() != 0)
+					if (it->template attribute<CPS::RightVectorStamp>("right_vector")->get().size() != 0)
 						mAttributeDependencies.push_back(it->attribute("right_vector"));
 				}
 				for (auto node : solver.mNodes) {
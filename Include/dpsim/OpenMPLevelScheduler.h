@@ -23,6 +23,6 @@ namespace DPsim {
 	private:
 		Int mNumThreads;
 		String mOutMeasurementFile;
-		std::vector<CPS::Task::List> mLevels;
+		TaskGraph mGraph;
 	};
 };
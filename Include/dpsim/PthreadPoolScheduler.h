@@ -41,9 +41,11 @@ namespace DPsim {
 
 		std::vector<pthread_t> mThreads;
 
+		TaskGraph mGraph;
+		/// Tasks of mGraph whose addresses are passed to the worker threads
 		CPS::Task::List mTasks;
-		Edges mInEdges;
-		Edges mOutEdges;
+		/// Number of predecessors of each task not executed yet in the current step
+		std::vector<Int> mPendingInDegrees;
 
 		struct queue_signalled mOutQueue;
 		struct queue_signalled mDoneQueue;
@@ -96,6 +96,8 @@ namespace Python {
 		static PyObject* addEventFD(Simulation *self, PyObject *args);
 		static PyObject* removeEventFD(Simulation *self, PyObject *args);
 		static PyObject* setScheduler(Simulation *self, PyObject *args, PyObject *kwargs);
+		static PyObject* doVectorLogging(Simulation *self, PyObject *args, PyObject *kwargs);
+		static PyObject* setVectorLogNodes(Simulation *self, PyObject *args);
 
 		// Setters
 		static int setFinalTime(Simulation *self, PyObject *val, void *ctx);
@@ -120,6 +122,8 @@ namespace Python {
 		static const char *docAddEventFD;
 		static const char *docRemoveEventFD;
 		static const char *docSetScheduler;
+		static const char *docDoVectorLogging;
+		static const char *docSetVectorLogNodes;
 		static const char *docState;
 		static const char *docName;
 		static PyMethodDef methods[];
@@ -0,0 +1,42 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include <dpsim/Config.h>
+#include <dpsim/Definitions.h>
+
+namespace DPsim {
+namespace RealTime {
+	/// Parses a list of CPUs like "2-5,7" as used by taskset and isolcpus
+	std::vector<Int> parseCpuList(const String& list);
+
+	/// Restricts the given thread to the given CPUs. If no thread is given,
+	/// the calling thread is used. Throws a SystemError on failure.
+	void setThreadAffinity(const std::vector<Int>& cpus, std::thread* thread = nullptr);
+	/// Sets the SCHED_FIFO policy with the given priority (1-99) for the given
+	/// thread or the calling thread. Requires CAP_SYS_NICE or a sufficient
+	/// RLIMIT_RTPRIO, otherwise a SystemError is thrown.
+	void setThreadPriority(Int priority, std::thread* thread = nullptr);
+
+	/// Locks all current and future pages of the process in memory and keeps
+	/// freed heap memory in the process so that it does not have to be faulted
+	/// in again. Requires CAP_IPC_LOCK or a sufficient RLIMIT_MEMLOCK.
+	void lockMemory();
+	/// Touches the given amount of stack of the calling thread so that
+	/// the pages are mapped before the real-time loop starts
+	void prefaultStack(std::size_t size = 512 * 1024);
+	/// Allocates and touches the given amount of heap memory, which is kept
+	/// by the allocator for later allocations if lockMemory was called
+	void prefaultHeap(std::size_t size);
+}
+}
@@ -11,6 +11,7 @@
 #include <signal.h>
 
 #include <chrono>
+#include <vector>
 
 #include <dpsim/Config.h>
 #include <dpsim/Simulation.h>
@@ -22,6 +23,14 @@ namespace DPsim {
 
 	protected:
 		Timer mTimer;
+		/// CPUs the simulation thread is restricted to, not changed if empty
+		std::vector<Int> mCpus;
+		/// SCHED_FIFO priority of the simulation thread, not changed if zero
+		Int mPriority = 0;
+		/// Lock the memory of the process before the first tick
+		Bool mMemoryLocking = false;
+		/// Heap memory to pre-fault if memory locking is enabled
+		std::size_t mPrefaultHeapSize = 0;
 
 	public:
 		/// Standard constructor
@@ -41,6 +50,21 @@ namespace DPsim {
 		void run(const Timer::StartClock::duration &startIn = std::chrono::seconds(1));
 
 		void run(const Timer::StartClock::time_point &startAt);
+
+		/// Restricts the thread running the simulation loop to the given CPUs.
+		/// The simulation loop runs as thread 0 of the scheduler, so this must
+		/// not be combined with Scheduler::setThreadAffinity.
+		void setThreadAffinity(const std::vector<Int>& cpus) { mCpus = cpus; }
+		/// Runs the simulation loop with the SCHED_FIFO policy and the given priority.
+		/// Must not be combined with Scheduler::setThreadPriority.
+		void setThreadPriority(Int priority) { mPriority = priority; }
+		/// Locks the memory of the process and pre-faults the stack and the
+		/// given amount of heap memory before the first tick to avoid page
+		/// faults in the simulation loop
+		void doMemoryLocking(Bool value = true, std::size_t prefaultHeapSize = 64 << 20) {
+			mMemoryLocking = value;
+			mPrefaultHeapSize = prefaultHeapSize;
+		}
 	};
 }
 
@@ -11,19 +11,26 @@
 #include <cps/Task.h>
 
 #include <dpsim/Definitions.h>
+#include <dpsim/TimeStatistics.h>
 #include <cps/Logger.h>
 
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
+#include <cstdint>
 #include <deque>
+#include <memory>
 #include <mutex>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 
 namespace DPsim {
 	// TODO extend / subclass
 	class SchedulingException {};
 
+	class TaskGraph;
+
 	class Scheduler {
 	public:
 		/// Edges describe the dependency from the first task to a list of other tasks
@@ -53,9 +60,33 @@ namespace DPsim {
 		/// Called on simulation stop to reliably clean up e.g. running helper threads
 		virtual void stop() {}
 
+		/// Pins the threads of the scheduler to the given CPUs, thread i to
+		/// cpus[i % cpus.size()]. Thread 0 is the thread calling step.
+		/// Must be called before the schedule is created. Schedulers that
+		/// cannot configure their threads throw when the schedule is created.
+		void setThreadAffinity(const std::vector<Int>& cpus) { mThreadCpus = cpus; }
+		/// Runs the threads of the scheduler with the SCHED_FIFO policy and the
+		/// given priority. Must be called before the schedule is created.
+		void setThreadPriority(Int priority) { mThreadPriority = priority; }
+		/// CPUs the threads are pinned to, empty if not pinned
+		const std::vector<Int>& threadAffinity() const { return mThreadCpus; }
+		/// SCHED_FIFO priority of the threads, zero if not changed
+		Int threadPriority() const { return mThreadPriority; }
+
 		/// Helper function that resolves the task-attribute dependencies to task-task dependencies
-		/// and inserts a root task
+		/// and inserts a root task. Tasks with a rate divisor are replaced by a
+		/// MultiRateTask executing them at their rate.
 		void resolveDeps(CPS::Task::List& tasks, Edges& inEdges, Edges& outEdges);
+		/// Merges chains of tasks and tasks of the same level into composite tasks
+		/// to reduce the scheduling overhead of small tasks. Tasks that are not
+		/// needed to reach the root task are removed first. The execution time of
+		/// a composite task should not exceed targetCost. The costs are read from
+		/// inMeasurementFile or taken from previous measurements of the scheduler.
+		/// Tasks without measurement are assumed to take defaultCost.
+		void coarsenTasks(CPS::Task::List& tasks, Edges& inEdges, Edges& outEdges,
+			TaskTime targetCost = std::chrono::microseconds(10),
+			CPS::String inMeasurementFile = "",
+			TaskTime defaultCost = std::chrono::microseconds(1));
 
 		// Special attribute that can be returned in the modified attributes of a task
 		// to mark that this task has external side-effects (like logging / interfacing)
@@ -66,6 +97,10 @@ namespace DPsim {
 		TaskTime getAveragedMeasurement(CPS::Task::Ptr task) {
 			return getAveragedMeasurement(task.get());
 		}
+		/// Statistics of the execution times of the task. Can be queried
+		/// while the simulation is running, but the values of a task
+		/// executed concurrently may be inconsistent.
+		const TimeStatistics& getMeasurementStatistics(CPS::Task::Ptr task);
 
 		/// Root task that has a dependency on the external attribute
 		/// which means that it should not be removed from the task graph
@@ -83,20 +118,40 @@ namespace DPsim {
 	protected:
 		/// Simple topological sort, filtering out tasks that do not need to be executed.
 		void topologicalSort(const CPS::Task::List& tasks, const Edges& inEdges, const Edges& outEdges, CPS::Task::List& sortedTasks);
-		/// Separate topologically sorted list of tasks into levels which can be
+		/// Sorts the tasks topologically and compiles the dependencies between
+		/// the remaining tasks into an integer-indexed graph
+		void compileGraph(const CPS::Task::List& tasks, const Edges& inEdges, const Edges& outEdges, TaskGraph& graph);
+		/// Separate the tasks of a compiled graph into levels which can be
 		/// executed in parallel
-		static void levelSchedule(const CPS::Task::List& tasks, const Edges& inEdges, const Edges& outEdges, std::vector<CPS::Task::List>& levels);
+		static void levelSchedule(const TaskGraph& graph, std::vector<CPS::Task::List>& levels);
 
-		void initMeasurements(const CPS::Task::List& tasks);
+		/// Creates the measurement entries of the tasks. If measured is set, the
+		/// tasks of composite tasks are measured individually so that their
+		/// measurements are written under their own names.
+		void initMeasurements(const CPS::Task::List& tasks, Bool measured = true);
 		/// Not thread-safe for multiple calls with same task, but should only
-		/// be called once for each task in each step anyway
+		/// be called once for each task in each step anyway. Tasks that were
+		/// not passed to initMeasurements are not measured.
 		void updateMeasurement(CPS::Task* task, TaskTime time);
-		/// Write measurement data to file
+		/// Write measurement data to file. Each line contains the task name,
+		/// the mean execution time followed by count, minimum, maximum and
+		/// the 50th, 99th and 99.9th percentile, all times in ns.
 		void writeMeasurements(CPS::String filename);
-		/// Read measurement data from file to use it for the scheduling
+		/// Read the mean execution times from a file written by writeMeasurements
+		/// to use it for the scheduling
 		void readMeasurements(CPS::String filename, std::unordered_map<CPS::String, TaskTime::rep>& measurements);
+		/// Adds the sum of the measurements of the tasks of each composite task
+		/// under the name of the composite task
+		static void addCompositeMeasurements(const CPS::Task::List& tasks,
+			std::unordered_map<CPS::String, TaskTime::rep>& measurements);
 		///
 		TaskTime getAveragedMeasurement(CPS::Task* task);
+		/// Replaces a group of tasks by a composite task executing them in the
+		/// given order and redirects the edges of the tasks to the composite task
+		CPS::Task::Ptr contractTasks(const CPS::Task::List& group, Edges& inEdges, Edges& outEdges);
+		/// Applies the configured affinity and priority to the given thread
+		/// of the scheduler. If no thread is given, the calling thread is used.
+		void configureThread(Int idx, std::thread* thread = nullptr);
 
 		///
 		CPS::Task::Ptr mRoot;
@@ -104,11 +159,134 @@ namespace DPsim {
 		CPS::Logger::Level mLogLevel;
 		/// Logger
 		CPS::Logger::Log mSLog;
+		/// CPUs to pin the threads to, not pinned if empty
+		std::vector<Int> mThreadCpus;
+		/// SCHED_FIFO priority of the threads, not changed if zero
+		Int mThreadPriority = 0;
+	private:
+		std::unordered_map<CPS::Task*, TimeStatistics> mMeasurements;
+	};
+
+	/// Dependency graph of the scheduled tasks in a compiled form. Tasks are
+	/// identified by their index in topological order and the edges are stored
+	/// as compressed sparse rows, so that schedulers can traverse the graph in
+	/// every step without hashing or allocating memory.
+	class TaskGraph {
+	public:
+		/// Builds the graph from a topologically sorted list of tasks.
+		/// Edges to tasks that are not in the list are dropped.
+		void compile(const CPS::Task::List& sortedTasks, const Scheduler::Edges& inEdges, const Scheduler::Edges& outEdges);
+
+		/// Number of tasks
+		Int size() const { return static_cast<Int>(mTasks.size()); }
+		/// Tasks in topological order
+		const CPS::Task::List& tasks() const { return mTasks; }
+		/// Task with the given index
+		CPS::Task* task(Int idx) const { return mTaskPtrs[idx]; }
+		/// Index of the task or -1 if the task is not part of the graph.
+		/// Should only be used when creating a schedule.
+		Int index(const CPS::Task* task) const {
+			auto it = mIndices.find(task);
+			return it == mIndices.end() ? -1 : it->second;
+		}
+
+		/// Successors of a task given as range of task indices
+		const Int* successorsBegin(Int idx) const { return mSuccessors.data() + mSuccessorPtr[idx]; }
+		const Int* successorsEnd(Int idx) const { return mSuccessors.data() + mSuccessorPtr[idx + 1]; }
+		/// Predecessors of a task given as range of task indices
+		const Int* predecessorsBegin(Int idx) const { return mPredecessors.data() + mPredecessorPtr[idx]; }
+		const Int* predecessorsEnd(Int idx) const { return mPredecessors.data() + mPredecessorPtr[idx + 1]; }
+		/// Number of predecessors of each task
+		const std::vector<Int>& inDegrees() const { return mInDegrees; }
+
+		/// Number of levels, i.e. length of the longest path in the graph
+		Int numLevels() const { return static_cast<Int>(mLevelPtr.size()) - 1; }
+		/// Level of a task, which is the length of the longest path from a task without predecessors
+		Int level(Int idx) const { return mLevels[idx]; }
+		/// Tasks of a level given as range of task indices in topological order
+		const Int* levelBegin(Int level) const { return mLevelTasks.data() + mLevelPtr[level]; }
+		const Int* levelEnd(Int level) const { return mLevelTasks.data() + mLevelPtr[level + 1]; }
+
 	private:
-		// TODO more sophisticated measurement method might be necessary for
-		// longer simulations (risk of high memory requirements and integer
-		// overflow)
-		std::unordered_map<CPS::Task*, std::vector<TaskTime>> mMeasurements;
+		CPS::Task::List mTasks;
+		std::vector<CPS::Task*> mTaskPtrs;
+		std::unordered_map<const CPS::Task*, Int> mIndices;
+
+		/// Offsets of the successor lists of each task in mSuccessors
+		std::vector<Int> mSuccessorPtr;
+		std::vector<Int> mSuccessors;
+		/// Offsets of the predecessor lists of each task in mPredecessors
+		std::vector<Int> mPredecessorPtr;
+		std::vector<Int> mPredecessors;
+		std::vector<Int> mInDegrees;
+
+		std::vector<Int> mLevels;
+		/// Offsets of the levels in mLevelTasks
+		std::vector<Int> mLevelPtr;
+		std::vector<Int> mLevelTasks;
+	};
+
+	/// Strategies of Barrier and Counter to wait for other threads
+	enum class WaitMode {
+		/// Busy waiting with the lowest latency, occupies the core while waiting
+		Spin,
+		/// Waiting on a condition variable
+		Condition,
+		/// Spinning for a calibrated time before parking the thread
+		Adaptive
+	};
+
+	/// Helpers for the spin-then-park waiting of Barrier and Counter
+	namespace AdaptiveWait {
+		/// Hints the processor that the thread is spinning
+		inline void relax() {
+#if defined(__x86_64__) || defined(__i386__)
+			__builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+			asm volatile("yield");
+#endif
+		}
+
+		/// Sets the time a thread spins before it is parked (default 20 us)
+		void setSpinBudget(std::chrono::nanoseconds budget);
+		/// Number of relax() calls taking about the spin budget, which is
+		/// calibrated on the first call
+		Int spinIterations();
+		/// Blocks the calling thread as long as word has the expected value.
+		/// May return spuriously.
+		void park(std::atomic<Int>& word, Int expected);
+		/// Wakes all threads parked on word
+		void wakeAll(std::atomic<Int>& word);
+
+		/// Spins until done returns true or the spin budget is exhausted
+		template<typename Done>
+		Bool spin(Done done) {
+			for (Int i = spinIterations(); i > 0; i--) {
+				if (done())
+					return true;
+				relax();
+			}
+			return done();
+		}
+	}
+
+	/// Counts how many adaptive waits finished while spinning and how many
+	/// parked the thread, which shows whether the spin budget fits the workload
+	class WaitStatistics {
+	public:
+		WaitStatistics() : mSpins(0), mParks(0) {}
+
+		void addSpin() { mSpins.fetch_add(1, std::memory_order_relaxed); }
+		void addPark() { mParks.fetch_add(1, std::memory_order_relaxed); }
+
+		/// Number of waits that finished while spinning
+		std::uint64_t spins() const { return mSpins.load(std::memory_order_relaxed); }
+		/// Number of waits that parked the thread
+		std::uint64_t parks() const { return mParks.load(std::memory_order_relaxed); }
+
+	private:
+		std::atomic<std::uint64_t> mSpins;
+		std::atomic<std::uint64_t> mParks;
 	};
 
 	/// A barrier is used to synchronize threads. Threads running into the barrier
@@ -121,13 +299,20 @@ namespace DPsim {
 		/// Limit sets the number of threads that need to reach the barrier
 		/// to release it.
 		Barrier(Int limit, Bool useCondition = false) :
-			mLimit(limit), mCount(0), mGeneration(0), mUseCondition(useCondition) {}
+			Barrier(limit, useCondition ? WaitMode::Condition : WaitMode::Spin) {}
+		Barrier(Int limit, WaitMode mode) :
+			mLimit(limit), mCount(0), mGeneration(0), mWaiters(0), mMode(mode) {}
+
+		/// Changes the wait strategy. Must not be called while threads are waiting.
+		void setWaitMode(WaitMode mode) { mMode = mode; }
+		/// Statistics of the adaptive waits
+		const WaitStatistics& waitStatistics() const { return mStatistics; }
 
 		/// Blocks until |limit| calls have been made, at which point all threads
 		/// return. Provides synchronization, i.e. all writes from before this call
 		/// are visible in all threads after this call.
 		void wait() {
-			if (mUseCondition) {
+			if (mMode == WaitMode::Condition) {
 				std::unique_lock<std::mutex> lk(mMutex);
 				Int gen = mGeneration;
 				mCount++;
@@ -148,10 +333,11 @@ namespace DPsim {
 				// and the fetch needs to be an acquire anyway, so use acq_rel instead of acquire.
 				// (This generates the same code on x86.)
 				if (mCount.fetch_add(1, std::memory_order_acq_rel) == mLimit-1) {
-					mCount.store(0, std::memory_order_relaxed);
-					mGeneration.fetch_add(1, std::memory_order_release);
-				} else {
+					release();
+				} else if (mMode == WaitMode::Spin) {
 					while (mGeneration.load(std::memory_order_acquire) == gen);
+				} else {
+					waitAdaptive(gen);
 				}
 			}
 		}
@@ -161,7 +347,7 @@ namespace DPsim {
 		/// other threads). Can be used to eliminate unnecessary waits if
 		/// multiple barriers are used in sequence.
 		void signal() {
-			if (mUseCondition) {
+			if (mMode == WaitMode::Condition) {
 				std::unique_lock<std::mutex> lk(mMutex);
 				mCount++;
 				if (mCount == mLimit) {
@@ -172,26 +358,150 @@ namespace DPsim {
 				}
 			} else {
 				// No release here, as this call does not provide any synchronization anyway.
-				if (mCount.fetch_add(1, std::memory_order_acquire) == mLimit-1) {
-					mCount.store(0, std::memory_order_relaxed);
-					mGeneration.fetch_add(1, std::memory_order_release);
-				}
+				if (mCount.fetch_add(1, std::memory_order_acquire) == mLimit-1)
+					release();
 			}
 		}
 
 	private:
+		/// Starts the next generation and wakes the parked threads
+		void release() {
+			mCount.store(0, std::memory_order_relaxed);
+			if (mMode == WaitMode::Spin) {
+				mGeneration.fetch_add(1, std::memory_order_release);
+			} else {
+				// Sequentially consistent, so that either a parking thread sees
+				// the new generation or the waiter count is seen here
+				mGeneration.fetch_add(1);
+				if (mWaiters.load() > 0)
+					AdaptiveWait::wakeAll(mGeneration);
+			}
+		}
+
+		void waitAdaptive(Int gen) {
+			auto released = [this, gen]() {
+				return mGeneration.load(std::memory_order_acquire) != gen;
+			};
+			if (AdaptiveWait::spin(released)) {
+				mStatistics.addSpin();
+				return;
+			}
+			mStatistics.addPark();
+			mWaiters.fetch_add(1);
+			while (mGeneration.load() == gen)
+				AdaptiveWait::park(mGeneration, gen);
+			mWaiters.fetch_sub(1, std::memory_order_relaxed);
+		}
+
 		/// Barrier limit which has to be reached before the barrier is released.
 		Int mLimit;
 		/// Barrier counter which is tested against limit
 		std::atomic<Int> mCount;
 		/// Allows multiple use of the barrier
 		std::atomic<Int> mGeneration;
-		Bool mUseCondition;
+		/// Number of parked threads
+		std::atomic<Int> mWaiters;
+		WaitMode mMode;
+		WaitStatistics mStatistics;
 
 		std::mutex mMutex;
 		std::condition_variable mCondition;
 	};
 
+	/// Task that can be executed by several threads at once. Schedulers that
+	/// support it execute the task concurrently on all of their threads, the
+	/// others call execute, which runs the share of a single thread.
+	class ParallelTask : public CPS::Task {
+	public:
+		typedef std::shared_ptr<ParallelTask> Ptr;
+
+		ParallelTask(std::string name) : Task(name) {}
+
+		/// Called when creating the schedule with the number of threads
+		/// that execute the task concurrently and the wait mode they use
+		/// to synchronize, which is that of the scheduler
+		virtual void setNumThreads(Int numThreads, WaitMode waitMode) = 0;
+		/// Executes the share of the given thread
+		virtual void executeThread(Real time, Int timeStepCount, Int thread) = 0;
+
+		void execute(Real time, Int timeStepCount) {
+			executeThread(time, timeStepCount, 0);
+		}
+	};
+
+	/// Task with side effects like logging that can be split into a snapshot
+	/// of the required data, which is taken in the step, and the processing
+	/// of this snapshot, which can be deferred to overlap with the following
+	/// steps. The snapshots are stored in a ring buffer of the given size.
+	class PipelinedTask : public CPS::Task {
+	public:
+		typedef std::shared_ptr<PipelinedTask> Ptr;
+
+		PipelinedTask(std::string name) : Task(name) {}
+
+		/// Allocates the buffer for the given number of snapshots
+		virtual void setBufferSize(UInt size) = 0;
+		/// Copies the data of the current step into the given buffer slot
+		virtual void snapshot(Real time, Int timeStepCount, UInt slot) = 0;
+		/// Processes the snapshot in the given buffer slot
+		virtual void process(UInt slot) = 0;
+	};
+
+	/// Task that executes several tasks in the given order.
+	/// It is created when coarsening the task graph.
+	class CompositeTask : public CPS::Task {
+	public:
+		typedef std::shared_ptr<CompositeTask> Ptr;
+
+		CompositeTask(const CPS::Task::List& tasks);
+
+		void execute(Real time, Int timeStepCount);
+
+		const CPS::Task::List& tasks() { return mTasks; }
+
+		/// Measure the execution time of each task in the given statistics
+		void setMeasurements(const std::vector<TimeStatistics*>& measurements) { mMeasurements = measurements; }
+
+	private:
+		CPS::Task::List mTasks;
+		/// Statistics of the tasks, not measured if empty
+		std::vector<TimeStatistics*> mMeasurements;
+	};
+
+	/// Task that executes another task only in every n-th time step according
+	/// to its rate divisor. In the other steps, the attributes modified by the
+	/// task hold their values or are interpolated linearly between the last
+	/// two results, which delays them by one period of the task.
+	/// Interpolation is supported for Real, Complex and matrix attributes
+	/// that are not defined by getters.
+	class MultiRateTask : public CPS::Task {
+	public:
+		MultiRateTask(CPS::Task::Ptr task);
+
+		void execute(Real time, Int timeStepCount);
+
+	private:
+		/// Results of the last two executions of an interpolated attribute
+		class Interpolation {
+		public:
+			virtual ~Interpolation() { }
+			/// Stores the current value as the latest result
+			virtual void update() = 0;
+			/// Sets the attribute to the latest result, so that the
+			/// task continues from its own last result
+			virtual void restore() = 0;
+			/// Sets the attribute to the value between the previous (weight 0)
+			/// and latest result (weight 1)
+			virtual void interpolate(Real weight) = 0;
+		};
+		template <typename T>
+		class InterpolationImpl;
+
+		CPS::Task::Ptr mTask;
+		UInt mRateDivisor;
+		std::vector<std::unique_ptr<Interpolation>> mInterpolations;
+	};
+
 	class BarrierTask : public CPS::Task {
 	public:
 		typedef std::shared_ptr<BarrierTask> Ptr;
@@ -202,19 +512,55 @@ namespace DPsim {
 		std::vector<Barrier*> mBarriers;
 	};
 
+	/// Counts the executions of a task. Threads wait for the counter to
+	/// reach the value of the current step.
 	class Counter {
 	public:
-		Counter() : mValue(0) {}
+		Counter() : mValue(0), mWaiters(0), mMode(WaitMode::Spin) {}
+
+		/// Changes the wait strategy. Condition variables are not supported,
+		/// so WaitMode::Condition behaves like WaitMode::Adaptive.
+		/// Must not be called while threads are waiting.
+		void setWaitMode(WaitMode mode) { mMode = mode; }
+		/// Statistics of the adaptive waits
+		const WaitStatistics& waitStatistics() const { return mStatistics; }
 
 		void inc() {
-			mValue.fetch_add(1, std::memory_order_release);
+			if (mMode == WaitMode::Spin) {
+				mValue.fetch_add(1, std::memory_order_release);
+			} else {
+				mValue.fetch_add(1);
+				if (mWaiters.load() > 0)
+					AdaptiveWait::wakeAll(mValue);
+			}
 		}
 
 		void wait(Int value) {
-			while (mValue.load(std::memory_order_acquire) != value);
+			if (mMode == WaitMode::Spin) {
+				while (mValue.load(std::memory_order_acquire) != value);
+				return;
+			}
+
+			auto reached = [this, value]() {
+				return mValue.load(std::memory_order_acquire) == value;
+			};
+			if (AdaptiveWait::spin(reached)) {
+				mStatistics.addSpin();
+				return;
+			}
+			mStatistics.addPark();
+			mWaiters.fetch_add(1);
+			Int current;
+			while ((current = mValue.load()) != value)
+				AdaptiveWait::park(mValue, current);
+			mWaiters.fetch_sub(1, std::memory_order_relaxed);
 		}
 
 	private:
 		std::atomic<Int> mValue;
+		/// Number of parked threads
+		std::atomic<Int> mWaiters;
+		WaitMode mMode;
+		WaitStatistics mStatistics;
 	};
 }
@@ -28,7 +28,7 @@ namespace DPsim {
 		void stop();
 
 	private:
-		CPS::Task::List mSchedule;
+		TaskGraph mGraph;
 
 		std::unordered_map<size_t, std::vector<std::chrono::nanoseconds>> mMeasurements;
 		std::vector<std::chrono::nanoseconds> mStepMeasurements;
@@ -14,6 +14,7 @@
 #include <dpsim/DataLogger.h>
 #include <dpsim/Solver.h>
 #include <dpsim/Scheduler.h>
+#include <dpsim/TaskPipeline.h>
 #include <dpsim/Event.h>
 #include <cps/Definitions.h>
 #include <cps/Logger.h>
@@ -48,11 +49,18 @@ namespace DPsim {
 		EventQueue mEvents;
 		/// System list
 		CPS::SystemTopology mSystem;
+		/// Additional scenarios with the same topology as mSystem
+		/// that are solved together with it
+		std::vector<CPS::SystemTopology> mScenarioSystems;
 
 		// #### Logging ####
 		/// Simulation log level
 		CPS::Logger::Level mLogLevel;
-		/// (Real) time needed for the timesteps
+		/// Statistics of the (real) time needed for the timesteps
+		TimeStatistics mStepTimeStatistics;
+		/// Store the time needed for each timestep in mStepTimes
+		Bool mStepTimeRecording = false;
+		/// (Real) time needed for the timesteps if recording is enabled
 		std::vector<Real> mStepTimes;
 
 		// #### Solver Settings ####
@@ -66,6 +74,26 @@ namespace DPsim {
 		Bool mPowerFlowInit = false;
 		/// Enable recomputation of system matrix during simulation
 		Bool mSystemMatrixRecomputation = false;
+		/// Number of switch configurations with cached factorization.
+		/// If this is zero, all configurations are precomputed.
+		UInt mSwitchCacheSize = 0;
+		/// Apply switching events as low-rank updates instead of
+		/// using a factorization for every switch configuration
+		Bool mSwitchLowRankUpdate = false;
+		/// Maximum rank of switch updates before the system is refactorized
+		UInt mSwitchMaxUpdateRank = 10;
+		/// Column ordering of the sparse LU factorization
+		Solver::NodeOrdering mNodeOrdering = Solver::NodeOrdering::COLAMD;
+		/// Solve the DP and SP system as complex matrix of half the dimension
+		Bool mComplexSparseSolve = false;
+		/// Compute the substitution of the solve with all scheduler threads
+		Bool mLevelScheduledSolve = false;
+		/// Downsampling of the logging of the solver vectors, disabled if zero
+		UInt mVectorLogDownsampling = 0;
+		/// Nodes whose entries of the solver vectors are logged, selected by
+		/// name or index. All nodes are logged if both are empty.
+		std::vector<String> mVectorLogNodeNames;
+		std::vector<UInt> mVectorLogNodeIndices;
 
 		/// Determines if the network should be split
 		/// into subnetworks at decoupling lines.
@@ -101,6 +129,18 @@ namespace DPsim {
 		CPS::Task::List mTasks;
 		/// Task dependencies as incoming / outgoing edges
 		Scheduler::Edges mTaskInEdges, mTaskOutEdges;
+		/// Merge small tasks into composite tasks before scheduling
+		Bool mTaskCoarsening = false;
+		/// Maximum execution time of a composite task
+		Scheduler::TaskTime mCoarseningTargetCost = std::chrono::microseconds(10);
+		/// Measurements of the task execution times used for the coarsening
+		String mCoarseningMeasurementFile;
+		/// Defer logging to a separate thread that overlaps with the following steps
+		Bool mPipelinedLogging = false;
+		/// Number of steps that can be buffered for deferred logging
+		UInt mPipelineBufferSize = 16;
+		/// Executes the deferred part of the pipelined tasks
+		std::unique_ptr<TaskPipeline> mPipeline;
 
 #ifdef WITH_SHMEM
 		struct InterfaceMapping {
@@ -163,6 +203,9 @@ namespace DPsim {
 		// #### Simulation Settings ####
 		///
 		void setSystem(CPS::SystemTopology system) { mSystem = system; }
+		/// Add a scenario with the same topology as the system but its own
+		/// components. All scenarios are advanced in lockstep by one MNA solver.
+		void addScenario(CPS::SystemTopology system) { mScenarioSystems.push_back(system); }
 		///
 		void setTimeStep(Real timeStep) { mTimeStep = timeStep; }
 		///
@@ -187,6 +230,54 @@ namespace DPsim {
 		void doFrequencyParallelization(Bool value) { mFreqParallel = value; }
 		///
 		void doSystemMatrixRecomputation(Bool value) { mSystemMatrixRecomputation = value; }
+		/// Factorize switch configurations on demand and keep the
+		/// least recently used ones up to the given number
+		void setSwitchCacheSize(UInt size) { mSwitchCacheSize = size; }
+		/// Apply switching events as low-rank updates to the factorization
+		/// of the initial configuration. The system is refactorized if
+		/// the rank of the update exceeds maxRank.
+		void doSwitchLowRankUpdate(Bool value, UInt maxRank = 10) {
+			mSwitchLowRankUpdate = value;
+			mSwitchMaxUpdateRank = maxRank;
+		}
+		/// Select the column ordering of the sparse LU factorization
+		void setNodeOrdering(Solver::NodeOrdering ordering) { mNodeOrdering = ordering; }
+		/// Solve phasor systems with a complex sparse LU instead of
+		/// splitting them into real and imaginary parts
+		void doComplexSparseSolve(Bool value = true) { mComplexSparseSolve = value; }
+		/// Parallelize the forward and backward substitution of the
+		/// solve over the threads of the scheduler
+		void doLevelScheduledSolve(Bool value = true) { mLevelScheduledSolve = value; }
+		/// Log the entries of the left and right side vectors of the MNA
+		/// solvers every downsampling steps, independent of the log level
+		void doVectorLogging(Bool value = true, UInt downsampling = 1) {
+			mVectorLogDownsampling = value ? std::max<UInt>(downsampling, 1) : 0;
+		}
+		/// Restrict the vector logging to the nodes with the given names
+		void setVectorLogNodes(const std::vector<String>& names) { mVectorLogNodeNames = names; }
+		/// Restrict the vector logging to the nodes with the given indices
+		/// of each solver, see Solver::setVectorLogNodes
+		void setVectorLogNodes(const std::vector<UInt>& indices) { mVectorLogNodeIndices = indices; }
+		/// Merge chains and independent tasks whose execution time is below
+		/// targetCost into composite tasks to reduce the scheduling overhead.
+		/// The execution times are read from inMeasurementFile, which is written
+		/// by the schedulers with their out measurement file.
+		void doTaskCoarsening(Bool value = true, Scheduler::TaskTime targetCost = std::chrono::microseconds(10),
+			String inMeasurementFile = "") {
+			mTaskCoarsening = value;
+			mCoarseningTargetCost = targetCost;
+			mCoarseningMeasurementFile = inMeasurementFile;
+		}
+		/// Only take snapshots of the logged and exported values in the step and
+		/// write them in a separate thread while the following steps are computed.
+		/// This applies to the data loggers, the vector logs of the solvers and
+		/// the exports of shared memory interfaces, which reach the remote
+		/// side later accordingly.
+		/// At most bufferSize steps are buffered before the simulation waits.
+		void doPipelinedLogging(Bool value = true, UInt bufferSize = 16) {
+			mPipelinedLogging = value;
+			mPipelineBufferSize = bufferSize;
+		}
 
 		// #### Initialization ####
 		/// activate steady state initialization
@@ -203,6 +294,12 @@ namespace DPsim {
 		void run();
 		/// Solve system A * x = z for x and current time
 		virtual Real step();
+		/// Waits until the deferred logging of all steps has finished
+		/// and stops the logging thread
+		void stopPipeline() {
+			if (mPipeline)
+				mPipeline->stop();
+		}
 		/// Synchronize simulation with remotes by exchanging intial state over interfaces
 		void sync();
 		/// Create the schedule for the independent tasks
@@ -218,7 +315,11 @@ namespace DPsim {
 		void addLogger(DataLogger::Ptr logger) {
 			mLoggers.push_back(logger);
 		}
-		/// Write step time measurements to log file
+		/// Store the time needed for each step in addition to the statistics.
+		/// The memory usage grows with the number of steps.
+		void doStepTimeRecording(Bool value = true) { mStepTimeRecording = value; }
+		/// Write step time measurements to log file. If the step times are not
+		/// recorded, only their statistics are written.
 		void logStepTimes(String logName);
 
 #ifdef WITH_SHMEM
@@ -242,6 +343,10 @@ namespace DPsim {
 		Real timeStep() const { return mTimeStep; }
 		DataLogger::List& loggers() { return mLoggers; }
 		std::shared_ptr<Scheduler> scheduler() { return mScheduler; }
+		Solver::List& solvers() { return mSolvers; }
+		/// Time needed for each step, only filled if step time recording is enabled
 		std::vector<Real>& stepTimes() { return mStepTimes; }
+		/// Statistics of the time needed for the steps
+		const TimeStatistics& stepTimeStatistics() const { return mStepTimeStatistics; }
 	};
 }
@@ -8,12 +8,14 @@
 
 #pragma once
 
+#include <algorithm>
 #include <iostream>
 #include <vector>
 #include <list>
 
 #include <dpsim/Definitions.h>
 #include <dpsim/Config.h>
+#include <dpsim/GraphOrdering.h>
 #include <cps/Logger.h>
 #include <cps/SystemTopology.h>
 #include <cps/Task.h>
@@ -27,6 +29,10 @@ namespace DPsim {
 
 	/// Base class for more specific solvers such as MNA, ODE or IDA.
 	class Solver {
+	public:
+		/// Column orderings of the sparse LU factorization of the system matrix
+		typedef GraphOrdering::Method NodeOrdering;
+
 	protected:
 		/// Name for logging
 		String mName;
@@ -38,6 +44,19 @@ namespace DPsim {
 		Real mTimeStep;
 		/// Activates parallelized computation of frequencies
 		Bool mFrequencyParallel = false;
+		/// Maximum number of switch configurations with cached factorization.
+		/// If this is zero, all configurations are precomputed.
+		UInt mSwitchCacheSize = 0;
+		/// Activates low-rank updates of the base factorization for switching
+		Bool mSwitchLowRankUpdate = false;
+		/// Maximum rank of switch updates before the system is refactorized
+		UInt mSwitchMaxUpdateRank = 10;
+		/// Column ordering of the sparse LU factorization
+		NodeOrdering mNodeOrdering = NodeOrdering::COLAMD;
+		/// Activates the complex sparse LU for phasor domains
+		Bool mComplexSparseSolve = false;
+		/// Activates the parallel level-scheduled substitution
+		Bool mLevelScheduledSolve = false;
 
 		// #### Initialization ####
 		/// steady state initialization time limit
@@ -52,6 +71,44 @@ namespace DPsim {
 		/// If this is false, all voltages are initialized with zero
 		Bool mPowerFlowInit = true;
 
+		// #### Vector logging ####
+		/// Downsampling of the logging of the left and right side vector,
+		/// which is disabled if zero
+		UInt mVectorLogDownsampling = 0;
+		/// Names and indices of the nodes whose vector entries are logged.
+		/// All nodes are logged if both are empty.
+		std::vector<String> mVectorLogNodeNames;
+		std::vector<UInt> mVectorLogNodeIndices;
+		/// Logged rows of the left and right side vector and their column names
+		std::vector<UInt> mVectorLogRows;
+		std::vector<String> mVectorLogColumns;
+
+		/// Returns true if the vector entries of the node with the given
+		/// index and name are logged
+		Bool isVectorLogNode(UInt idx, const String& name) const {
+			if (mVectorLogNodeNames.empty() && mVectorLogNodeIndices.empty())
+				return true;
+			return std::find(mVectorLogNodeIndices.begin(), mVectorLogNodeIndices.end(), idx) != mVectorLogNodeIndices.end()
+				|| std::find(mVectorLogNodeNames.begin(), mVectorLogNodeNames.end(), name) != mVectorLogNodeNames.end();
+		}
+		/// Reports selected nodes that are not part of the solver
+		void checkVectorLogNodes(const std::vector<String>& names) {
+			for (auto& name : mVectorLogNodeNames) {
+				if (std::find(names.begin(), names.end(), name) == names.end())
+					mSLog->info("Node {} selected for vector logging is not part of this solver", name);
+			}
+			for (auto idx : mVectorLogNodeIndices) {
+				if (idx >= names.size())
+					mSLog->info("Node index {} selected for vector logging is not part of this solver", idx);
+			}
+		}
+		/// Copies the logged rows of a vector
+		void gatherVectorLogRows(const Matrix& vector, Matrix& values) const {
+			values.resize(mVectorLogRows.size(), 1);
+			for (UInt i = 0; i < mVectorLogRows.size(); i++)
+				values(i, 0) = vector(mVectorLogRows[i], 0);
+		}
+
 	public:
 		typedef std::shared_ptr<Solver> Ptr;
 		typedef std::vector<Ptr> List;
@@ -77,6 +134,50 @@ namespace DPsim {
 		void doFrequencyParallelization(Bool freqParallel) {
 			mFrequencyParallel = freqParallel;
 		}
+		/// Factorize system matrices of switch configurations on demand
+		/// and keep at most the given number of them
+		void setSwitchCacheSize(UInt size) {
+			mSwitchCacheSize = size;
+		}
+		/// Apply switching events as low-rank corrections to the
+		/// factorization of the initial switch configuration. The system
+		/// is refactorized if the rank of the correction exceeds maxRank.
+		void doSwitchLowRankUpdate(Bool f, UInt maxRank = 10) {
+			mSwitchLowRankUpdate = f;
+			mSwitchMaxUpdateRank = maxRank;
+		}
+		/// Select the column ordering of the sparse LU factorization, which
+		/// determines the fill-in of the factors. Dense factorizations do
+		/// not use an ordering.
+		void setNodeOrdering(NodeOrdering ordering) {
+			mNodeOrdering = ordering;
+		}
+		/// Solve the system as complex matrix of half the dimension
+		/// instead of splitting it into real and imaginary parts
+		void doComplexSparseSolve(Bool value = true) {
+			mComplexSparseSolve = value;
+		}
+		/// Split the forward and backward substitution into levels
+		/// that are computed by all threads of the scheduler
+		void doLevelScheduledSolve(Bool value = true) {
+			mLevelScheduledSolve = value;
+		}
+		/// Log the entries of the left and right side vector every
+		/// downsampling steps, independent of the log level. The column
+		/// names are derived from the node names.
+		void doVectorLogging(Bool value = true, UInt downsampling = 1) {
+			mVectorLogDownsampling = value ? std::max<UInt>(downsampling, 1) : 0;
+		}
+		/// Restrict the vector logging to the nodes with the given names
+		void setVectorLogNodes(const std::vector<String>& names) {
+			mVectorLogNodeNames = names;
+		}
+		/// Restrict the vector logging to the nodes with the given indices,
+		/// which count the nodes of the solver without ground, followed by
+		/// the virtual nodes of the components
+		void setVectorLogNodes(const std::vector<UInt>& indices) {
+			mVectorLogNodeIndices = indices;
+		}
 		///
 		virtual void setSystem(CPS::SystemTopology system) {}
 
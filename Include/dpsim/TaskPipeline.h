@@ -0,0 +1,73 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <dpsim/Scheduler.h>
+
+namespace DPsim {
+	/// Processes the snapshots of pipelined tasks in a separate thread while
+	/// the following steps are computed. Only the snapshots are taken in the
+	/// scheduled step. If all buffer slots are in use, the next step waits
+	/// until the oldest snapshot has been processed.
+	class TaskPipeline {
+	public:
+		TaskPipeline(UInt bufferSize = 16);
+		~TaskPipeline();
+
+		/// Registers a pipelined task and returns the task taking its
+		/// snapshots, which has to be scheduled instead
+		CPS::Task::Ptr addTask(PipelinedTask::Ptr task);
+
+		/// Waits for a free buffer slot. Must be called before each step.
+		void beginStep();
+		/// Hands the snapshots of the step over to the pipeline thread.
+		/// Must be called after each step.
+		void endStep();
+		/// Waits until all snapshots have been processed
+		void flush();
+		/// Processes the remaining snapshots and stops the pipeline thread
+		void stop();
+
+		/// Buffer slot of the current step
+		UInt currentSlot() const { return mCurrentSlot; }
+
+	private:
+		/// Task that takes the snapshot of a pipelined task
+		class SnapshotTask : public CPS::Task {
+		public:
+			SnapshotTask(PipelinedTask::Ptr task, TaskPipeline& pipeline);
+
+			void execute(Real time, Int timeStepCount);
+
+		private:
+			PipelinedTask::Ptr mTask;
+			TaskPipeline& mPipeline;
+		};
+
+		void threadFunction();
+
+		UInt mBufferSize;
+		std::vector<PipelinedTask::Ptr> mTasks;
+		std::thread mThread;
+
+		std::mutex mMutex;
+		std::condition_variable mCondition;
+		/// Number of steps handed over to the pipeline thread
+		UInt mSubmitted = 0;
+		/// Number of steps processed by the pipeline thread
+		UInt mProcessed = 0;
+		UInt mCurrentSlot = 0;
+		Bool mStopping = false;
+	};
+}
@@ -0,0 +1,44 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <dpsim/ThreadScheduler.h>
+
+namespace DPsim {
+	/// Static list scheduler based on the Heterogeneous Earliest Finish Time
+	/// (HEFT) heuristic. Tasks are prioritized by their upward rank, which is
+	/// the length of the critical path from the task to the end of the step,
+	/// and assigned to the thread on which they finish first. Dependencies
+	/// between tasks on different threads are charged with syncCost.
+	class ThreadHEFTScheduler : public ThreadScheduler {
+	public:
+		ThreadHEFTScheduler(Int threads = 1, String outMeasurementFile = String(), String inMeasurementFile = String(),
+			Bool useConditionVariables = false, TaskTime syncCost = std::chrono::microseconds(1));
+
+		void createSchedule(const CPS::Task::List& tasks, const Edges& inEdges, const Edges& outEdges);
+		void step(Real time, Int timeStepCount);
+		void stop();
+
+		/// Step time predicted from the task costs when creating the schedule
+		TaskTime predictedStepTime() { return mPredictedStepTime; }
+		/// Average step time measured so far
+		TaskTime averageStepTime() {
+			return mNumSteps > 0 ? mTotalStepTime / mNumSteps : TaskTime(0);
+		}
+
+	private:
+		String mInMeasurementFile;
+		/// Cost of a dependency between tasks executed by different threads
+		TaskTime mSyncCost;
+
+		TaskTime mPredictedStepTime = TaskTime(0);
+		TaskTime mTotalStepTime = TaskTime(0);
+		Int mNumSteps = 0;
+	};
+};
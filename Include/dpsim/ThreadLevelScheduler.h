@@ -18,7 +18,7 @@ namespace DPsim {
 		void createSchedule(const CPS::Task::List& tasks, const Edges& inEdges, const Edges& outEdges);
 
 	private:
-		void scheduleLevel(const CPS::Task::List& tasks, const std::unordered_map<String, TaskTime::rep>& measurements, const Edges& inEdges);
+		void scheduleLevel(const CPS::Task::List& tasks, const std::unordered_map<String, TaskTime::rep>& measurements);
 		void sortTasksByType(CPS::Task::List::iterator begin, CPS::Task::List::iterator end);
 
 		String mInMeasurementFile;
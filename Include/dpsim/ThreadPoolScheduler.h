@@ -0,0 +1,63 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <dpsim/DynamicThreadScheduler.h>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+namespace DPsim {
+	/// Scheduler that executes the tasks dynamically with a pool of threads.
+	/// Ready tasks are kept in a single lock-free queue shared by all threads.
+	class ThreadPoolScheduler : public DynamicThreadScheduler {
+	public:
+		ThreadPoolScheduler(Int threads = 1, String outMeasurementFile = String());
+
+	protected:
+		void initReadyTasks();
+		void pushReadyTask(Int thread, Int task);
+		Bool popReadyTask(Int thread, Int& task);
+
+	private:
+		/// Bounded multi-producer multi-consumer queue of task indices after
+		/// D. Vyukov. Each cell carries a sequence number that tells producers
+		/// and consumers whether it is free or filled for their position.
+		class TaskQueue {
+		public:
+			TaskQueue() : mHead(0), mTail(0), mMask(0) {}
+
+			/// Allocates space for at least capacity tasks. Not thread-safe.
+			void init(std::size_t capacity);
+			/// Returns false if the queue is full
+			Bool push(Int task);
+			/// Returns false if the queue is empty
+			Bool pop(Int& task);
+
+		private:
+			struct Cell {
+				std::atomic<std::size_t> sequence;
+				Int task;
+			};
+
+			std::unique_ptr<Cell[]> mCells;
+			/// Keeps producers and consumers on different cache lines.
+			/// alignas would require aligned new, which is not part of C++11.
+			char mPadding0[64];
+			std::atomic<std::size_t> mHead;
+			char mPadding1[64];
+			std::atomic<std::size_t> mTail;
+			char mPadding2[64];
+			std::size_t mMask;
+		};
+
+		TaskQueue mReadyTasks;
+	};
+}
@@ -22,24 +22,41 @@ namespace DPsim {
 		void step(Real time, Int timeStepCount);
 		virtual void stop();
 
+		/// Sets how the threads wait for each other and for the next step.
+		/// WaitMode::Adaptive frees the cores between the steps of a real-time
+		/// simulation. Must be called before the schedule is created.
+		void setWaitMode(WaitMode mode);
+		/// Number of adaptive waits of all threads that finished while
+		/// spinning and that parked the thread
+		void waitStatistics(std::uint64_t& spins, std::uint64_t& parks) const;
+
 	protected:
-		void finishSchedule(const Edges& inEdges);
+		/// Creates the counters for the dependencies given by mGraph
+		/// between the scheduled tasks and starts the threads
+		void finishSchedule();
 		void scheduleTask(int thread, CPS::Task::Ptr task);
 
 		Int mNumThreads;
+		/// Compiled dependency graph of the tasks to schedule
+		TaskGraph mGraph;
+		/// File the task measurements are written to, not measured if empty
+		String mOutMeasurementFile;
 
 	private:
 		void doStep(Int scheduleIdx);
 		static void threadFunction(ThreadScheduler* sched, Int idx);
 
-		String mOutMeasurementFile;
 		Barrier mStartBarrier;
+		/// Wait strategy of the counters and of parallel tasks
+		WaitMode mWaitMode;
 
 		std::vector<std::thread> mThreads;
 
 		std::vector<CPS::Task::List> mTempSchedules;
 		struct ScheduleEntry {
 			CPS::Task* task;
+			/// Set if the task is executed by all threads
+			ParallelTask* parallelTask;
 			Counter endCounter;
 			std::vector<Counter*> reqCounters;
 		};
@@ -0,0 +1,60 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include <dpsim/Definitions.h>
+
+namespace DPsim {
+	/// Online statistics of time measurements with constant memory usage.
+	/// Besides count, mean, minimum and maximum, the measurements are counted
+	/// in a histogram with logarithmically growing buckets, each split into
+	/// linear sub-buckets (similar to HDR histograms). Percentiles are
+	/// computed from the histogram with a relative error of about 3%.
+	class TimeStatistics {
+	public:
+		typedef std::chrono::nanoseconds Duration;
+
+		TimeStatistics();
+
+		/// Adds a measurement. Not thread-safe.
+		void add(Duration time);
+		/// Removes all measurements
+		void reset();
+
+		/// Number of measurements
+		uint64_t count() const { return mCount; }
+		Duration mean() const;
+		Duration min() const { return Duration(mCount > 0 ? mMin : 0); }
+		Duration max() const { return Duration(mMax); }
+		/// Value below which the given fraction (between 0 and 1) of the measurements lies
+		Duration percentile(Real fraction) const;
+
+	private:
+		/// Number of linear sub-buckets per power of two is 2^mSubBucketBits
+		static const Int mSubBucketBits = 5;
+		/// Measurements larger than 2^mMaxBits ns (about 68 s) are
+		/// counted in the last bucket
+		static const Int mMaxBits = 36;
+
+		static Int bucketIndex(uint64_t value);
+		/// Value in the middle of the given bucket
+		static uint64_t bucketValue(Int index);
+
+		uint64_t mCount = 0;
+		/// Sum of the measurements in ns
+		Real mSum = 0;
+		uint64_t mMin = 0;
+		uint64_t mMax = 0;
+		std::vector<uint64_t> mBuckets;
+	};
+}
@@ -0,0 +1,48 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <dpsim/DynamicThreadScheduler.h>
+
+#include <deque>
+#include <memory>
+#include <mutex>
+
+namespace DPsim {
+	/// Scheduler that assigns the tasks to threads at runtime. Each thread
+	/// keeps a queue of ready tasks. Tasks become ready when all of their
+	/// predecessors have been executed and are pushed to the queue of the
+	/// thread that executed the last predecessor. Idle threads steal tasks
+	/// from the queues of the other threads.
+	class WorkStealingScheduler : public DynamicThreadScheduler {
+	public:
+		WorkStealingScheduler(Int threads = 1, String outMeasurementFile = String());
+
+	protected:
+		void initReadyTasks() { }
+		/// The thread that resolves the last dependency of a
+		/// task continues with it to keep the data local
+		void pushReadyTask(Int thread, Int task);
+		/// Takes a task from the own queue or steals one from another thread
+		Bool popReadyTask(Int thread, Int& task);
+
+	private:
+		/// Queue of ready tasks of one thread. The owner takes tasks from the
+		/// back, other threads steal from the front.
+		struct TaskQueue {
+			std::mutex mutex;
+			std::deque<Int> tasks;
+			/// Keeps the queues of different threads on different cache lines.
+			/// alignas would require aligned new, which is not part of C++11.
+			char padding[64];
+		};
+
+		std::unique_ptr<TaskQueue[]> mQueues;
+	};
+}
@@ -0,0 +1,158 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <stdexcept>
+
+#include <dpsim/BinaryLog.h>
+
+#ifdef HAVE_MMAP
+  #include <fcntl.h>
+  #include <unistd.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+#endif
+
+using namespace DPsim;
+
+template<typename T>
+static T readValue(const char* data, std::size_t size, std::size_t& offset) {
+	if (offset + sizeof(T) > size)
+		throw std::runtime_error("Binary log header is truncated");
+
+	T value;
+	std::memcpy(&value, data + offset, sizeof(T));
+	offset += sizeof(T);
+	return value;
+}
+
+BinaryLogReader::BinaryLogReader(const fs::path& filename) {
+#ifdef HAVE_MMAP
+	int fd = ::open(filename.c_str(), O_RDONLY);
+	if (fd < 0)
+		throw std::runtime_error("Cannot open binary log " + filename.string());
+
+	struct stat st;
+	if (fstat(fd, &st) == 0 && st.st_size > 0) {
+		void* data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (data != MAP_FAILED) {
+			mData = static_cast<const char*>(data);
+			mSize = st.st_size;
+		}
+	}
+	::close(fd);
+#endif
+
+	if (!mData) {
+		std::ifstream file(filename, std::ios_base::binary);
+		if (!file.is_open())
+			throw std::runtime_error("Cannot open binary log " + filename.string());
+		mBuffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+		mData = mBuffer.data();
+		mSize = mBuffer.size();
+	}
+
+	try {
+		std::size_t offset = 0;
+		if (mSize < sizeof(BinaryLog::magic) || std::memcmp(mData, BinaryLog::magic, sizeof(BinaryLog::magic)))
+			throw std::runtime_error("Not a binary log: " + filename.string());
+		offset += sizeof(BinaryLog::magic);
+
+		auto version = readValue<std::uint32_t>(mData, mSize, offset);
+		if (version != BinaryLog::version)
+			throw std::runtime_error("Unsupported binary log version " + std::to_string(version));
+		auto columns = readValue<std::uint32_t>(mData, mSize, offset);
+		readValue<std::uint32_t>(mData, mSize, offset);
+		auto headerSize = readValue<std::uint32_t>(mData, mSize, offset);
+
+		for (std::uint32_t col = 0; col < columns; col++) {
+			auto type = readValue<std::uint8_t>(mData, mSize, offset);
+			readValue<std::uint8_t>(mData, mSize, offset);
+			auto length = readValue<std::uint16_t>(mData, mSize, offset);
+			if (offset + length > mSize)
+				throw std::runtime_error("Binary log header is truncated");
+			mTypes.push_back(static_cast<BinaryLog::ColumnType>(type));
+			mNames.emplace_back(mData + offset, length);
+			offset += length;
+		}
+
+		offset = headerSize;
+		while (offset + sizeof(std::uint64_t) <= mSize) {
+			auto rows = readValue<std::uint64_t>(mData, mSize, offset);
+			std::size_t bytes = rows * columns * sizeof(Real);
+			if (offset + bytes > mSize)
+				break;
+			mBlocks.push_back({ offset, static_cast<std::size_t>(rows) });
+			mRows += rows;
+			offset += bytes;
+		}
+	}
+	catch (...) {
+#ifdef HAVE_MMAP
+		if (mBuffer.empty() && mData)
+			munmap(const_cast<char*>(mData), mSize);
+#endif
+		throw;
+	}
+}
+
+BinaryLogReader::~BinaryLogReader() {
+#ifdef HAVE_MMAP
+	if (mBuffer.empty() && mData)
+		munmap(const_cast<char*>(mData), mSize);
+#endif
+}
+
+std::size_t BinaryLogReader::columnIndex(const String& name) const {
+	for (std::size_t idx = 0; idx < mNames.size(); idx++) {
+		if (mNames[idx] == name)
+			return idx;
+	}
+	throw std::out_of_range("No column " + name + " in binary log");
+}
+
+const Real* BinaryLogReader::blockColumn(std::size_t block, std::size_t column) const {
+	auto& b = mBlocks[block];
+	return reinterpret_cast<const Real*>(mData + b.offset) + column * b.rows;
+}
+
+std::vector<Real> BinaryLogReader::column(std::size_t column) const {
+	std::vector<Real> values(mRows);
+	auto it = values.begin();
+	for (std::size_t block = 0; block < mBlocks.size(); block++) {
+		const Real* data = blockColumn(block, column);
+		it = std::copy(data, data + mBlocks[block].rows, it);
+	}
+	return values;
+}
+
+void BinaryLogReader::writeCSV(std::ostream& out) const {
+	out << std::right << std::setw(14) << "time";
+	for (std::size_t col = 1; col < mNames.size(); col++)
+		out << ", " << std::right << std::setw(13) << mNames[col];
+	out << '\n';
+
+	for (std::size_t block = 0; block < mBlocks.size(); block++) {
+		for (std::size_t row = 0; row < mBlocks[block].rows; row++) {
+			out << std::scientific << std::right << std::setw(14) << blockColumn(block, 0)[row];
+			for (std::size_t col = 1; col < mNames.size(); col++) {
+				Real value = blockColumn(block, col)[row];
+				out << ", " << std::right << std::setw(13);
+				if (mTypes[col] == BinaryLog::ColumnType::Int)
+					out << std::to_string(static_cast<Int>(value));
+				else
+					out << std::to_string(value);
+			}
+			out << '\n';
+		}
+	}
+}
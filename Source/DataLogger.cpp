@@ -6,7 +6,12 @@
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  *********************************************************************************/
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <iomanip>
+#include <iterator>
+#include <limits>
 
 #include <dpsim/DataLogger.h>
 #include <cps/Logger.h>
@@ -16,18 +21,22 @@ using namespace DPsim;
 DataLogger::DataLogger(Bool enabled) :
 	mLogFile(),
 	mEnabled(enabled),
-	mDownsampling(1) {
+	mDownsampling(1),
+	mFormat(Format::CSV) {
 	mLogFile.setstate(std::ios_base::badbit);
+	initAttributes();
 }
 
-DataLogger::DataLogger(String name, Bool enabled, UInt downsampling) :
+DataLogger::DataLogger(String name, Bool enabled, UInt downsampling, Format format) :
 	mName(name),
 	mEnabled(enabled),
-	mDownsampling(downsampling) {
+	mDownsampling(downsampling),
+	mFormat(format) {
+	initAttributes();
 	if (!mEnabled)
 		return;
 
-	mFilename = CPS::Logger::logDir() + "/" + name + ".csv";
+	mFilename = CPS::Logger::logDir() + "/" + name + (format == Format::Binary ? ".bin" : ".csv");
 
 	if (mFilename.has_parent_path() && !fs::exists(mFilename.parent_path()))
 		fs::create_directory(mFilename.parent_path());
@@ -36,7 +45,9 @@ DataLogger::DataLogger(String name, Bool enabled, UInt downsampling) :
 }
 
 void DataLogger::open() {
-	mLogFile = std::ofstream(mFilename, std::ios_base::out|std::ios_base::trunc);
+	mBinaryColumns = 0;
+	mBlockFill = 0;
+	mLogFile = std::ofstream(mFilename, std::ios_base::out|std::ios_base::trunc|std::ios_base::binary);
 	if (!mLogFile.is_open()) {
 		// TODO: replace by exception
 		std::cerr << "Cannot open log file " << mFilename << std::endl;
@@ -44,11 +55,110 @@ void DataLogger::open() {
 	}
 }
 
+void DataLogger::initAttributes() {
+	mAsyncHead = 0;
+	mAsyncTail = 0;
+	mAsyncSignal = 0;
+	mAsyncWaiting = false;
+	mAsyncFreeSignal = 0;
+	mAsyncBlocked = false;
+	mAsyncStopping = false;
+	mAsyncOverflows = 0;
+
+	AttributeList::addAttribute<Int>("overflows", nullptr, [this]() {
+		return static_cast<Int>(mAsyncOverflows.load(std::memory_order_relaxed));
+	}, CPS::Flags::read);
+	AttributeList::addAttribute<Int>("lag", nullptr, [this]() {
+		return static_cast<Int>(mAsyncHead.load(std::memory_order_relaxed) - mAsyncTail.load(std::memory_order_relaxed));
+	}, CPS::Flags::read);
+}
+
 void DataLogger::close() {
+	stopAsync();
+	if (mAggregation && mWindowSamples > 0 && mLogFile.is_open()) {
+		finishWindow();
+		logRow(mRowTime, mRowValues, mRowStrings);
+	}
+	if (mFormat == Format::Binary)
+		flushBinaryBlock();
 	mLogFile.close();
 }
 
+void DataLogger::writeBinaryHeader(const std::vector<String>& names,
+	const std::vector<BinaryLog::ColumnType>& types) {
+
+	mBinaryColumns = static_cast<UInt>(names.size()) + 1;
+	std::uint32_t headerSize = sizeof(BinaryLog::magic) + 4 * sizeof(std::uint32_t);
+	// Column descriptors including the time column
+	headerSize += 4 + 4;
+	for (auto& name : names)
+		headerSize += 4 + static_cast<std::uint32_t>(std::min<std::size_t>(name.size(), 0xffff));
+	headerSize = (headerSize + 7) / 8 * 8;
+
+	// Blocks of about 1 MiB keep the writes large and the buffer small
+	mBlockRows = std::max<UInt>(1, std::min<UInt>(4096, (1 << 20) / (sizeof(Real) * mBinaryColumns)));
+	mBlock.assign(mBlockRows * mBinaryColumns, 0);
+	mBinaryRow.resize(names.size());
+	mBlockFill = 0;
+
+	std::vector<char> header(headerSize, 0);
+	char* pos = header.data();
+	auto put = [&pos](const void* data, std::size_t size) {
+		std::memcpy(pos, data, size);
+		pos += size;
+	};
+	std::uint32_t fields[] = { BinaryLog::version, mBinaryColumns, mBlockRows, headerSize };
+	put(BinaryLog::magic, sizeof(BinaryLog::magic));
+	put(fields, sizeof(fields));
+
+	auto putColumn = [&put](const String& name, BinaryLog::ColumnType type) {
+		std::uint8_t desc[2] = { static_cast<std::uint8_t>(type), 0 };
+		std::uint16_t length = static_cast<std::uint16_t>(std::min<std::size_t>(name.size(), 0xffff));
+		put(desc, sizeof(desc));
+		put(&length, sizeof(length));
+		put(name.data(), length);
+	};
+	putColumn("time", BinaryLog::ColumnType::Real);
+	for (std::size_t idx = 0; idx < names.size(); idx++)
+		putColumn(names[idx], types[idx]);
+
+	mLogFile.write(header.data(), header.size());
+}
+
+void DataLogger::logBinaryRow(Real time, const std::vector<Real>& values) {
+	if (values.size() + 1 != mBinaryColumns)
+		throw std::invalid_argument("Number of values does not match the columns of " + mFilename.string());
+
+	mBlock[mBlockFill] = time;
+	for (UInt col = 1; col < mBinaryColumns; col++)
+		mBlock[col * mBlockRows + mBlockFill] = values[col - 1];
+
+	if (++mBlockFill == mBlockRows)
+		flushBinaryBlock();
+}
+
+void DataLogger::flushBinaryBlock() {
+	if (mBlockFill == 0)
+		return;
+
+	std::uint64_t rows = mBlockFill;
+	mLogFile.write(reinterpret_cast<const char*>(&rows), sizeof(rows));
+	if (mBlockFill == mBlockRows) {
+		mLogFile.write(reinterpret_cast<const char*>(mBlock.data()), mBlock.size() * sizeof(Real));
+	} else {
+		for (UInt col = 0; col < mBinaryColumns; col++)
+			mLogFile.write(reinterpret_cast<const char*>(&mBlock[col * mBlockRows]), mBlockFill * sizeof(Real));
+	}
+	mBlockFill = 0;
+}
+
 void DataLogger::setColumnNames(std::vector<String> names) {
+	if (mFormat == Format::Binary) {
+		if (mLogFile.tellp() == std::ofstream::pos_type(0))
+			writeBinaryHeader(names, std::vector<BinaryLog::ColumnType>(names.size(), BinaryLog::ColumnType::Real));
+		return;
+	}
+
 	if (mLogFile.tellp() == std::ofstream::pos_type(0)) {
 		mLogFile << std::right << std::setw(14) << "time";
 		for (auto name : names) {
@@ -62,6 +172,12 @@ void DataLogger::logDataLine(Real time, Real data) {
 	if (!mEnabled)
 		return;
 
+	if (mFormat == Format::Binary) {
+		mBinaryRow.assign(1, data);
+		logBinaryRow(time, mBinaryRow);
+		return;
+	}
+
 	mLogFile << std::scientific << std::right << std::setw(14) << time;
 	mLogFile << ", " << std::right << std::setw(13) << data;
 	mLogFile << '\n';
@@ -71,6 +187,14 @@ void DataLogger::logDataLine(Real time, const Matrix& data) {
 	if (!mEnabled)
 		return;
 
+	if (mFormat == Format::Binary) {
+		mBinaryRow.resize(data.rows());
+		for (Int i = 0; i < data.rows(); i++)
+			mBinaryRow[i] = data(i, 0);
+		logBinaryRow(time, mBinaryRow);
+		return;
+	}
+
 	mLogFile << std::scientific << std::right << std::setw(14) << time;
 	for (Int i = 0; i < data.rows(); i++) {
 		mLogFile << ", " << std::right << std::setw(13) << data(i, 0);
@@ -81,6 +205,17 @@ void DataLogger::logDataLine(Real time, const Matrix& data) {
 void DataLogger::logDataLine(Real time, const MatrixComp& data) {
 	if (!mEnabled)
 		return;
+
+	// The binary format stores the real and imaginary part of each entry
+	if (mFormat == Format::Binary) {
+		mBinaryRow.resize(2 * data.rows());
+		for (Int i = 0; i < data.rows(); i++) {
+			mBinaryRow[2*i] = data(i, 0).real();
+			mBinaryRow[2*i + 1] = data(i, 0).imag();
+		}
+		logBinaryRow(time, mBinaryRow);
+		return;
+	}
 	mLogFile << std::scientific << std::right << std::setw(14) << time;
 	for (Int i = 0; i < data.rows(); i++) {
 		mLogFile << ", " << std::right << std::setw(13) << data(i, 0);
@@ -127,37 +262,485 @@ void DataLogger::logEMTNodeValues(Real time, const Matrix& data) {
 	logDataLine(time, data);
 }
 
-void DataLogger::log(Real time, Int timeStepCount) {
-	if (!mEnabled || !(timeStepCount % mDownsampling == 0))
+void DataLogger::resolveColumns() {
+	if (mColumnsResolved)
+		return;
+
+	// Matrices are usually resized during the initialization of the
+	// simulation, so the sources are only resolved when the first row is
+	// written. The entries are read through the matrix, which stays valid
+	// if the matrix is reallocated.
+	mColumns.clear();
+	mHasOtherColumns = false;
+	for (auto it : mAttributes) {
+		Column col;
+		auto source = mSources.find(it.first);
+		if (source != mSources.end()) {
+			auto& src = source->second;
+			col.row = src.row;
+			col.col = src.col;
+			col.imag = src.imag;
+			if (auto comp = std::dynamic_pointer_cast<CPS::Attribute<Complex>>(src.attr)) {
+				if (auto value = comp->valuePointer()) {
+					col.kind = Column::Kind::Real;
+					col.real = reinterpret_cast<const Real*>(value) + (src.imag ? 1 : 0);
+				}
+			}
+			else if (auto mat = std::dynamic_pointer_cast<CPS::Attribute<Matrix>>(src.attr)) {
+				auto value = mat->valuePointer();
+				if (value && col.row < value->rows() && col.col < value->cols()) {
+					col.kind = Column::Kind::RealMatrix;
+					col.matrix = value;
+				}
+			}
+			else if (auto mat = std::dynamic_pointer_cast<CPS::Attribute<MatrixComp>>(src.attr)) {
+				auto value = mat->valuePointer();
+				if (value && col.row < value->rows() && col.col < value->cols()) {
+					col.kind = Column::Kind::CompMatrix;
+					col.matrixComp = value;
+				}
+			}
+		}
+
+		if (!col.real && !col.matrix && !col.matrixComp) {
+			if ((col.realGetter = std::dynamic_pointer_cast<CPS::Attribute<Real>>(it.second))) {
+				col.real = col.realGetter->valuePointer();
+				col.kind = col.real ? Column::Kind::Real : Column::Kind::RealGetter;
+			}
+			else if ((col.intGetter = std::dynamic_pointer_cast<CPS::Attribute<Int>>(it.second))) {
+				col.integer = col.intGetter->valuePointer();
+				col.kind = col.integer ? Column::Kind::Int : Column::Kind::IntGetter;
+			}
+			else {
+				col.kind = Column::Kind::Other;
+				col.other = it.second;
+				mHasOtherColumns = true;
+			}
+		}
+		mColumns.push_back(col);
+	}
+
+	resolveOutputs();
+	mColumnsResolved = true;
+}
+
+void DataLogger::resolveOutputs() {
+	mOutputNames.clear();
+	mOutputTypes.clear();
+	mChannels.clear();
+	mWindowSamples = 0;
+
+	std::vector<String> names;
+	for (auto it : mAttributes)
+		names.push_back(it.first);
+
+	auto columnType = [this](UInt idx) {
+		switch (mColumns[idx].kind) {
+		case Column::Kind::Int:
+		case Column::Kind::IntGetter:
+			return BinaryLog::ColumnType::Int;
+		case Column::Kind::Other:
+			return BinaryLog::ColumnType::Other;
+		default:
+			return BinaryLog::ColumnType::Real;
+		}
+	};
+
+	if (!mAggregation) {
+		for (UInt idx = 0; idx < mColumns.size(); idx++) {
+			mOutputNames.push_back(names[idx]);
+			mOutputTypes.push_back(columnType(idx));
+		}
+		mRowValues.resize(mOutputNames.size());
+		mRowStrings.resize(mOutputNames.size());
 		return;
+	}
+
+	mStatistics = mAggregation & (AggregateMin | AggregateMax | AggregateMean | AggregateRMS);
+	if (!mStatistics)
+		mStatistics = AggregateMean;
+
+	std::vector<Bool> paired(mColumns.size(), false);
+	for (UInt idx = 0; idx < mColumns.size(); idx++) {
+		if (paired[idx])
+			continue;
+
+		Channel ch = Channel();
+		ch.column = idx;
+		ch.imag = -1;
+		ch.output = static_cast<UInt>(mOutputNames.size());
+		ch.integer = columnType(idx) == BinaryLog::ColumnType::Int;
+		ch.other = columnType(idx) == BinaryLog::ColumnType::Other;
+		String name = names[idx];
+
+		// The parts of a complex value are added as name.re and name.im
+		auto source = mSources.find(name);
+		if ((mAggregation & AggregatePhasor) && source != mSources.end() && name.size() > 3
+			&& name.compare(name.size() - 3, 3, source->second.imag ? ".im" : ".re") == 0) {
+			String base = name.substr(0, name.size() - 3);
+			auto partner = mSources.find(base + (source->second.imag ? ".re" : ".im"));
+			if (partner != mSources.end() && partner->second.attr == source->second.attr
+				&& partner->second.row == source->second.row
+				&& partner->second.col == source->second.col
+				&& partner->second.imag != source->second.imag) {
+				UInt partnerIdx = static_cast<UInt>(std::distance(mAttributes.begin(), mAttributes.find(partner->first)));
+				ch.column = source->second.imag ? partnerIdx : idx;
+				ch.imag = source->second.imag ? idx : partnerIdx;
+				paired[partnerIdx] = true;
+				name = base;
+			}
+		}
+
+		if (ch.other) {
+			mOutputNames.push_back(name);
+			mOutputTypes.push_back(BinaryLog::ColumnType::Other);
+		}
+		else {
+			String valueName = ch.imag >= 0 ? name + ".mag" : name;
+			auto addOutput = [&](UInt statistic, const String& suffix, Bool integer) {
+				if (!(mStatistics & statistic))
+					return;
+				mOutputNames.push_back(valueName + suffix);
+				mOutputTypes.push_back(integer ? BinaryLog::ColumnType::Int : BinaryLog::ColumnType::Real);
+			};
+			addOutput(AggregateMin, ".min", ch.integer);
+			addOutput(AggregateMax, ".max", ch.integer);
+			addOutput(AggregateMean, ".mean", false);
+			addOutput(AggregateRMS, ".rms", false);
+			if (ch.imag >= 0) {
+				mOutputNames.push_back(name + ".phase");
+				mOutputTypes.push_back(BinaryLog::ColumnType::Real);
+			}
+		}
+		mChannels.push_back(ch);
+	}
+
+	mSampleValues.resize(mColumns.size());
+	mRowValues.resize(mOutputNames.size());
+	mRowStrings.resize(mOutputNames.size());
+}
+
+Bool DataLogger::takesRow(Real time, Int timeStepCount) {
+	if (!mAggregation)
+		return timeStepCount % mDownsampling == 0;
+
+	aggregate(time);
+	if (mWindowSamples < mDownsampling)
+		return false;
+
+	finishWindow();
+	return true;
+}
+
+void DataLogger::aggregate(Real time) {
+	readValues(mSampleValues.data());
+
+	if (mWindowSamples == 0) {
+		mWindowTime = time;
+		for (auto& ch : mChannels) {
+			ch.min = std::numeric_limits<Real>::infinity();
+			ch.max = -std::numeric_limits<Real>::infinity();
+			ch.sum = ch.sumSquares = ch.sumReal = ch.sumImag = 0;
+		}
+	}
+
+	for (auto& ch : mChannels) {
+		if (ch.other)
+			continue;
+
+		Real value = mSampleValues[ch.column];
+		if (ch.imag >= 0) {
+			Real imag = mSampleValues[ch.imag];
+			ch.sumReal += value;
+			ch.sumImag += imag;
+			value = std::sqrt(value * value + imag * imag);
+		}
+		ch.min = std::min(ch.min, value);
+		ch.max = std::max(ch.max, value);
+		ch.sum += value;
+		ch.sumSquares += value * value;
+	}
+	mWindowSamples++;
+}
+
+void DataLogger::finishWindow() {
+	Real samples = static_cast<Real>(mWindowSamples);
+	for (auto& ch : mChannels) {
+		UInt out = ch.output;
+		if (ch.other) {
+			mRowValues[out] = std::numeric_limits<Real>::quiet_NaN();
+			if (mFormat == Format::CSV)
+				mRowStrings[out] = mColumns[ch.column].other->toString();
+			continue;
+		}
+
+		if (mStatistics & AggregateMin)
+			mRowValues[out++] = ch.min;
+		if (mStatistics & AggregateMax)
+			mRowValues[out++] = ch.max;
+		if (mStatistics & AggregateMean)
+			mRowValues[out++] = ch.sum / samples;
+		if (mStatistics & AggregateRMS)
+			mRowValues[out++] = std::sqrt(ch.sumSquares / samples);
+		if (ch.imag >= 0)
+			mRowValues[out++] = std::atan2(ch.sumImag, ch.sumReal);
+	}
+	mRowTime = mWindowTime;
+	mWindowSamples = 0;
+}
+
+void DataLogger::readRow(Real time, Real& rowTime, std::vector<Real>& values, std::vector<String>& strings) {
+	if (mAggregation) {
+		rowTime = mRowTime;
+		values = mRowValues;
+		if (mHasOtherColumns)
+			strings = mRowStrings;
+		return;
+	}
+
+	rowTime = time;
+	values.resize(mColumns.size());
+	readValues(values.data());
+	if (mHasOtherColumns && mFormat == Format::CSV) {
+		strings.resize(mColumns.size());
+		for (UInt idx = 0; idx < mColumns.size(); idx++) {
+			if (mColumns[idx].kind == Column::Kind::Other)
+				strings[idx] = mColumns[idx].other->toString();
+		}
+	}
+}
+
+void DataLogger::readValues(Real* values) const {
+	for (UInt idx = 0; idx < mColumns.size(); idx++) {
+		auto& col = mColumns[idx];
+		switch (col.kind) {
+		case Column::Kind::Real:
+			values[idx] = *col.real;
+			break;
+		case Column::Kind::Int:
+			values[idx] = static_cast<Real>(*col.integer);
+			break;
+		case Column::Kind::RealMatrix:
+			values[idx] = (*col.matrix)(col.row, col.col);
+			break;
+		case Column::Kind::CompMatrix:
+			values[idx] = col.imag ? (*col.matrixComp)(col.row, col.col).imag()
+				: (*col.matrixComp)(col.row, col.col).real();
+			break;
+		case Column::Kind::RealGetter:
+			values[idx] = col.realGetter->getByValue();
+			break;
+		case Column::Kind::IntGetter:
+			values[idx] = static_cast<Real>(col.intGetter->getByValue());
+			break;
+		case Column::Kind::Other:
+			values[idx] = std::numeric_limits<Real>::quiet_NaN();
+			break;
+		}
+	}
+}
+
+void DataLogger::logCSVRow(Real time, const std::vector<Real>& values, const std::vector<String>& strings) {
+	mLogFile << std::scientific << std::right << std::setw(14) << time;
+	for (UInt idx = 0; idx < mOutputTypes.size(); idx++) {
+		mLogFile << ", " << std::right << std::setw(13);
+		switch (mOutputTypes[idx]) {
+		case BinaryLog::ColumnType::Int:
+			mLogFile << std::to_string(static_cast<Int>(values[idx]));
+			break;
+		case BinaryLog::ColumnType::Other:
+			mLogFile << strings[idx];
+			break;
+		default:
+			mLogFile << std::to_string(values[idx]);
+		}
+	}
+	mLogFile << '\n';
+}
+
+void DataLogger::logRow(Real time, const std::vector<Real>& values, const std::vector<String>& strings) {
+	logHeader();
+	if (mFormat == Format::Binary)
+		logBinaryRow(time, values);
+	else
+		logCSVRow(time, values, strings);
+}
+
+void DataLogger::logHeader() {
+	if (mFormat == Format::Binary) {
+		if (mBinaryColumns == 0)
+			writeBinaryHeader(mOutputNames, mOutputTypes);
+		return;
+	}
 
 	if (mLogFile.tellp() == std::ofstream::pos_type(0)) {
 		mLogFile << std::right << std::setw(14) << "time";
-		for (auto it : mAttributes)
-			mLogFile << ", " << std::right << std::setw(13) << it.first;
+		for (auto& name : mOutputNames)
+			mLogFile << ", " << std::right << std::setw(13) << name;
 		mLogFile << '\n';
 	}
+}
 
-	mLogFile << std::scientific << std::right << std::setw(14) << time;
-	for (auto it : mAttributes)
-		mLogFile << ", " << std::right << std::setw(13) << it.second->toString();
-	mLogFile << '\n';
+void DataLogger::start() {
+	if (!mEnabled)
+		return;
+
+	resolveColumns();
+	if (mAsyncBufferSize > 0 && !mAsyncWriter.joinable()) {
+		if (!mAsyncStep) {
+			mAsyncStep = std::make_shared<Step>(*this);
+			mAsyncStep->setBufferSize(mAsyncBufferSize);
+		}
+		mAsyncStopping = false;
+		mAsyncWriter = std::thread(&DataLogger::asyncWriterFunction, this);
+	}
+}
+
+void DataLogger::log(Real time, Int timeStepCount) {
+	if (!mEnabled)
+		return;
+
+	start();
+	if (!takesRow(time, timeStepCount))
+		return;
+
+	if (mAsyncBufferSize > 0) {
+		logAsync(time);
+		return;
+	}
+
+	if (!mAggregation)
+		readRow(time, mRowTime, mRowValues, mRowStrings);
+	logRow(mRowTime, mRowValues, mRowStrings);
+}
+
+void DataLogger::logAsync(Real time) {
+	std::uint64_t head = mAsyncHead.load(std::memory_order_relaxed);
+	auto full = [this, head]() {
+		return head - mAsyncTail.load() >= mAsyncBufferSize;
+	};
+	if (full()) {
+		mAsyncOverflows.fetch_add(1, std::memory_order_relaxed);
+		if (mOverflowPolicy == OverflowPolicy::Drop)
+			return;
+		if (!AdaptiveWait::spin([&full]() { return !full(); })) {
+			// Sequentially consistent, so that either the writer thread sees
+			// this thread blocked or this thread sees the written row
+			mAsyncBlocked.store(true);
+			while (true) {
+				Int signal = mAsyncFreeSignal.load();
+				if (!full())
+					break;
+				AdaptiveWait::park(mAsyncFreeSignal, signal);
+			}
+			mAsyncBlocked.store(false, std::memory_order_relaxed);
+		}
+	}
+
+	mAsyncStep->copyRow(time, head % mAsyncBufferSize);
+	// Sequentially consistent, so that either the writer thread sees
+	// the new row or it is seen waiting here
+	mAsyncHead.store(head + 1);
+	if (mAsyncWaiting.load()) {
+		mAsyncSignal.fetch_add(1);
+		AdaptiveWait::wakeAll(mAsyncSignal);
+	}
+}
+
+void DataLogger::asyncWriterFunction() {
+	while (true) {
+		std::uint64_t tail = mAsyncTail.load(std::memory_order_relaxed);
+		if (tail == mAsyncHead.load()) {
+			if (mAsyncStopping.load())
+				return;
+
+			Int signal = mAsyncSignal.load();
+			mAsyncWaiting.store(true);
+			if (tail == mAsyncHead.load() && !mAsyncStopping.load())
+				AdaptiveWait::park(mAsyncSignal, signal);
+			mAsyncWaiting.store(false, std::memory_order_relaxed);
+			continue;
+		}
+
+		mAsyncStep->process(tail % mAsyncBufferSize);
+		mAsyncTail.store(tail + 1);
+		if (mAsyncBlocked.load()) {
+			mAsyncFreeSignal.fetch_add(1);
+			AdaptiveWait::wakeAll(mAsyncFreeSignal);
+		}
+	}
+}
+
+void DataLogger::stopAsync() {
+	if (!mAsyncWriter.joinable())
+		return;
+
+	mAsyncStopping.store(true);
+	mAsyncSignal.fetch_add(1);
+	AdaptiveWait::wakeAll(mAsyncSignal);
+	mAsyncWriter.join();
 }
 
 void DataLogger::Step::execute(Real time, Int timeStepCount) {
 	mLogger.log(time, timeStepCount);
 }
 
+void DataLogger::Step::setBufferSize(UInt size) {
+	mSnapshots.assign(size, Snapshot());
+	for (auto& snapshot : mSnapshots) {
+		snapshot.values.resize(mLogger.mAttributes.size());
+		snapshot.strings.resize(mLogger.mAttributes.size());
+	}
+}
+
+void DataLogger::Step::snapshot(Real time, Int timeStepCount, UInt slot) {
+	mSnapshots[slot].valid = false;
+	if (!mLogger.mEnabled)
+		return;
+
+	// The columns are resolved here, as the pipeline thread only
+	// processes the snapshots
+	mLogger.resolveColumns();
+	if (mLogger.takesRow(time, timeStepCount))
+		copyRow(time, slot);
+}
+
+void DataLogger::Step::copyRow(Real time, UInt slot) {
+	auto& snapshot = mSnapshots[slot];
+	mLogger.readRow(time, snapshot.time, snapshot.values, snapshot.strings);
+	snapshot.valid = true;
+}
+
+void DataLogger::Step::process(UInt slot) {
+	auto& snapshot = mSnapshots[slot];
+	if (!snapshot.valid)
+		return;
+
+	mLogger.logRow(snapshot.time, snapshot.values, snapshot.strings);
+}
+
 CPS::Task::Ptr DataLogger::getTask() {
 	return std::make_shared<DataLogger::Step>(*this);
 }
 
-void DataLogger::addAttribute(const String &name, CPS::Attribute<Int>::Ptr attr) {
+void DataLogger::addColumn(const String &name, CPS::AttributeBase::Ptr attr) {
 	mAttributes[name] = attr;
+	mSources.erase(name);
+	mColumnsResolved = false;
 }
 
-void DataLogger::addAttribute(const String &name, CPS::Attribute<Real>::Ptr attr) {
+void DataLogger::addColumn(const String &name, CPS::AttributeBase::Ptr attr, const Source &source) {
 	mAttributes[name] = attr;
+	mSources[name] = source;
+	mColumnsResolved = false;
+}
+
+void DataLogger::addAttribute(const String &name, CPS::Attribute<Int>::Ptr attr) {
+	addColumn(name, attr);
+}
+
+void DataLogger::addAttribute(const String &name, CPS::Attribute<Real>::Ptr attr) {
+	addColumn(name, attr);
 }
 
 void DataLogger::addAttribute(const String &name, const String &attr, CPS::IdentifiedObject::Ptr obj) {
@@ -167,8 +750,8 @@ void DataLogger::addAttribute(const String &name, const String &attr, CPS::Ident
 void DataLogger::addAttribute(const String &name, CPS::Attribute<Complex>::Ptr attr) {
 	auto attrComp = std::static_pointer_cast<CPS::ComplexAttribute>(attr);
 
-	mAttributes[name + ".re"] = attrComp->real();
-	mAttributes[name + ".im"] = attrComp->imag();
+	addColumn(name + ".re", attrComp->real(), { attr, 0, 0, false });
+	addColumn(name + ".im", attrComp->imag(), { attr, 0, 0, true });
 }
 
 void DataLogger::addAttribute(const std::vector<String> &name, CPS::MatrixRealAttribute::Ptr attr) {
@@ -176,19 +759,19 @@ void DataLogger::addAttribute(const std::vector<String> &name, CPS::MatrixRealAt
 	auto attrMat = std::static_pointer_cast<CPS::MatrixRealAttribute>(attr);
 
 	if (m.rows() == 1 && m.cols() == 1) {
-		addAttribute(name[0], attrMat->coeff(0, 0));
+		addColumn(name[0], attrMat->coeff(0, 0), { attr, 0, 0, false });
 	}
 	else if (m.cols() == 1) {
 		for (UInt k = 0; k < m.rows(); k++) {
-			addAttribute(name[k],
-				attrMat->coeff(k, 0));
+			addColumn(name[k],
+				attrMat->coeff(k, 0), { attr, k, 0, false });
 		}
 	}
 	else {
 		for (UInt k = 0; k < m.rows(); k++) {
 			for (UInt l = 0; l < m.cols(); l++) {
-				addAttribute(name[k*m.cols()+l],
-					attrMat->coeff(k, l));
+				addColumn(name[k*m.cols()+l],
+					attrMat->coeff(k, l), { attr, k, l, false });
 			}
 		}
 	}
@@ -199,19 +782,19 @@ void DataLogger::addAttribute(const String &name, CPS::MatrixRealAttribute::Ptr
 	auto attrMat = std::static_pointer_cast<CPS::MatrixRealAttribute>(attr);
 
 	if (m.rows() == 1 && m.cols() == 1) {
-		addAttribute(name, attrMat->coeff(0, 0));
+		addColumn(name, attrMat->coeff(0, 0), { attr, 0, 0, false });
 	}
 	else if (m.cols() == 1) {
 		for (UInt k = 0; k < m.rows(); k++) {
-			addAttribute(name + "_" + std::to_string(k),
-				attrMat->coeff(k, 0));
+			addColumn(name + "_" + std::to_string(k),
+				attrMat->coeff(k, 0), { attr, k, 0, false });
 		}
 	}
 	else {
 		for (UInt k = 0; k < m.rows(); k++) {
 			for (UInt l = 0; l < m.cols(); l++) {
-				addAttribute(name + "_" + std::to_string(k) + "_" + std::to_string(l) + "_",
-					attrMat->coeff(k, l));
+				addColumn(name + "_" + std::to_string(k) + "_" + std::to_string(l) + "_",
+					attrMat->coeff(k, l), { attr, k, l, false });
 			}
 		}
 	}
@@ -225,23 +808,23 @@ void DataLogger::addAttribute(const String &name, CPS::MatrixCompAttribute::Ptr
 
 	if (m.rows() == 1 && m.cols() == 1) {
 		//addAttribute(name, attrMat->coeff(0, 0));
-		mAttributes[name + ".re"] = attrMat->coeffReal(0,0);
-		mAttributes[name + ".im"] = attrMat->coeffImag(0,0);
+		addColumn(name + ".re", attrMat->coeffReal(0,0), { attr, 0, 0, false });
+		addColumn(name + ".im", attrMat->coeffImag(0,0), { attr, 0, 0, true });
 	}
 	else if (m.cols() == 1) {
 		for (UInt k = 0; k < rowsMax; k++) {
 			//addAttribute(name + "(" + std::to_string(k) + ")", attrMat->coeff(k, 0));
-			mAttributes[name + "_" + std::to_string(k) + ".re"] = attrMat->coeffReal(k,0);
-			mAttributes[name + "_" + std::to_string(k) + ".im"] = attrMat->coeffImag(k,0);
+			addColumn(name + "_" + std::to_string(k) + ".re", attrMat->coeffReal(k,0), { attr, k, 0, false });
+			addColumn(name + "_" + std::to_string(k) + ".im", attrMat->coeffImag(k,0), { attr, k, 0, true });
 		}
 	}
 	else {
 		for (UInt k = 0; k < rowsMax; k++) {
 			for (UInt l = 0; l < colsMax; l++) {
-				mAttributes[name + "_" + std::to_string(k) + "_" + std::to_string(l)
-					+ ".re"] = attrMat->coeffReal(k,l);
-				mAttributes[name + "_" + std::to_string(k) + "_" + std::to_string(l)
-					+ ".im"] = attrMat->coeffImag(k,l);
+				addColumn(name + "_" + std::to_string(k) + "_" + std::to_string(l) + ".re",
+					attrMat->coeffReal(k,l), { attr, k, l, false });
+				addColumn(name + "_" + std::to_string(k) + "_" + std::to_string(l) + ".im",
+					attrMat->coeffImag(k,l), { attr, k, l, true });
 			}
 		}
 	}
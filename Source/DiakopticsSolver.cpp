@@ -8,8 +8,6 @@
 
 #include <dpsim/DiakopticsSolver.h>
 
-#include <iomanip>
-
 #include <cps/MathUtils.h>
 #include <cps/Solver/MNATearInterface.h>
 #include <dpsim/Definitions.h>
@@ -26,10 +24,6 @@ DiakopticsSolver<VarType>::DiakopticsSolver(String name,
 	Solver(name, logLevel) {
 	mTimeStep = timeStep;
 
-	// Raw source and solution vector logging
-	mLeftVectorLog = std::make_shared<DataLogger>(name + "_LeftVector", logLevel != CPS::Logger::Level::off);
-	mRightVectorLog = std::make_shared<DataLogger>(name + "_RightVector", logLevel != CPS::Logger::Level::off);
-
 	for (auto comp : tearComponents) {
 		auto pcomp = std::dynamic_pointer_cast<SimPowerComp<VarType>>(comp);
 		if (pcomp)
@@ -46,7 +40,6 @@ void DiakopticsSolver<VarType>::init(SystemTopology& system) {
 
 	system.splitSubnets<VarType>(subnets);
 	initSubnets(subnets);
-	setLogColumns();
 	createMatrices();
 	initComponents();
 	initMatrices();
@@ -180,28 +173,6 @@ void DiakopticsSolver<Complex>::setSubnetSize(int net, UInt nodes) {
 	mSubnets[net].mCmplOff = nodes;
 }
 
-template<>
-void DiakopticsSolver<Real>::setLogColumns() {
-	// nothing to do, column names generated by DataLogger are correct
-}
-
-template<>
-void DiakopticsSolver<Complex>::setLogColumns() {
-	std::vector<String> names;
-	for (auto& subnet : mSubnets) {
-		for (UInt i = subnet.sysOff; i < subnet.sysOff + subnet.sysSize; i++) {
-			std::stringstream name;
-			if (i < subnet.sysOff + subnet.mCmplOff)
-				name << "node" << std::setfill('0') << std::setw(5) << i - subnet.sysOff / 2 << ".real";
-			else
-				name << "node" << std::setfill('0') << std::setw(5) << i - (subnet.sysOff + subnet.sysSize) / 2 << ".imag";
-			names.push_back(name.str());
-		}
-	}
-	mLeftVectorLog->setColumnNames(names);
-	mRightVectorLog->setColumnNames(names);
-}
-
 template <typename VarType>
 void DiakopticsSolver<VarType>::createMatrices() {
 	UInt totalSize = mSubnets.back().sysOff + mSubnets.back().sysSize;
@@ -254,7 +225,7 @@ void DiakopticsSolver<VarType>::initComponents() {
 		// Initialize MNA specific parts of components.
 		for (auto comp : mSubnets[net].components) {
 			comp->mnaInitialize(mSystem.mSystemOmega, mTimeStep, mSubnets[net].leftVector);
-			const Matrix& stamp = comp->template attribute<Matrix>("right_vector")->get();
+			const RightVectorStamp& stamp = comp->template attribute<RightVectorStamp>("right_vector")->get();
 			if (stamp.size() != 0) {
 				mSubnets[net].rightVectorStamps.push_back(&stamp);
 			}
@@ -262,20 +233,21 @@ void DiakopticsSolver<VarType>::initComponents() {
 	}
 	// Initialize signal components.
 	for (auto comp : mSimSignalComps)
-		comp->initialize(mSystem.mSystemOmega, mTimeStep);
+		comp->initialize(mSystem.mSystemOmega, mTimeStep * comp->rateDivisor());
 }
 
 template <typename VarType>
 void DiakopticsSolver<VarType>::initMatrices() {
 	for (auto& net : mSubnets) {
 		// We can't directly pass the block reference to mnaApplySystemMatrixStamp,
-		// because it expects a concrete Matrix. It can't be changed to accept some common
+		// because it expects a concrete sparse matrix. It can't be changed to accept some common
 		// base class like DenseBase because that would make it a template function (as
 		// Eigen uses CRTP for polymorphism), which is impossible for virtual functions.
-		Matrix partSys = Matrix::Zero(net.sysSize, net.sysSize);
+		SparseMatrixRow partSysSparse(net.sysSize, net.sysSize);
 		for (auto comp : net.components) {
-			comp->mnaApplySystemMatrixStamp(partSys);
+			comp->mnaApplySystemMatrixStamp(partSysSparse);
 		}
+		Matrix partSys = Matrix(partSysSparse);
 		auto block = mSystemMatrix.block(net.sysOff, net.sysOff, net.sysSize, net.sysSize);
 		block = partSys;
 		mSLog->info("Block: \n{}", block);
@@ -302,7 +274,9 @@ void DiakopticsSolver<VarType>::initMatrices() {
 		Matrix rInit = Matrix::Zero(net.sysSize, 1);
 
 		for (auto comp : net.components) {
-			comp->mnaApplyRightSideVectorStamp(rInit);
+			RightVectorStamp stamp(net.sysSize);
+			comp->mnaApplyRightSideVectorStamp(stamp);
+			stamp.addTo(rInit);
 		}
 		mSLog->info("Source block: \n{}", rInit);
 	}
@@ -354,7 +328,7 @@ Task::List DiakopticsSolver<VarType>::getTasks() {
 	}
 
 	for (auto comp : mSimSignalComps) {
-		for (auto task : comp->getTasks()) {
+		for (auto task : comp->getTasksAtRate()) {
 			l.push_back(task);
 		}
 	}
@@ -362,6 +336,11 @@ Task::List DiakopticsSolver<VarType>::getTasks() {
 	l.push_back(std::make_shared<PostSolveTask>(*this));
 	l.push_back(std::make_shared<LogTask>(*this));
 
+	// The solver is initialized in its constructor before the vector logging
+	// options can be set, so the loggers are created with the tasks
+	if (mVectorLogDownsampling > 0)
+		initializeVectorLogging();
+
 	return l;
 }
 
@@ -371,7 +350,7 @@ void DiakopticsSolver<VarType>::SubnetSolveTask::execute(Real time, Int timeStep
 	rBlock.setZero();
 
 	for (auto stamp : mSubnet.rightVectorStamps)
-		rBlock += *stamp;
+		stamp->addTo(mSolver.mRightSideVector, mSubnet.sysOff);
 
 	auto lBlock = mSolver.mOrigLeftSideVector.block(mSubnet.sysOff, 0, mSubnet.sysSize, 1);
 	// Solve Y' * v' = I
@@ -424,21 +403,95 @@ void DiakopticsSolver<VarType>::PostSolveTask::execute(Real time, Int timeStepCo
 	}
 }
 
-template <>
-void DiakopticsSolver<Real>::log(Real time) {
-	mLeftVectorLog->logEMTNodeValues(time, mLeftSideVector);
-	mRightVectorLog->logEMTNodeValues(time, mRightSideVector);
+template <typename VarType>
+void DiakopticsSolver<VarType>::log(Real time, Int timeStepCount) {
+	if (!isVectorLogStep(timeStepCount))
+		return;
+
+	gatherVectorLogRows(mLeftSideVector, mLeftVectorValues);
+	gatherVectorLogRows(mRightSideVector, mRightVectorValues);
+	logVectors(time, mLeftVectorValues, mRightVectorValues);
 }
 
-template <>
-void DiakopticsSolver<Complex>::log(Real time) {
-	mLeftVectorLog->logPhasorNodeValues(time, mLeftSideVector);
-	mRightVectorLog->logPhasorNodeValues(time, mRightSideVector);
+template <typename VarType>
+void DiakopticsSolver<VarType>::initializeVectorLogging() {
+	if (mLeftVectorLog)
+		return;
+
+	mVectorLogRows.clear();
+	mVectorLogColumns.clear();
+
+	// The block of each subnet holds the real parts of its nodes followed
+	// by the imaginary parts in the phasor domain
+	const String phases[] = { "_A", "_B", "_C" };
+	std::vector<String> names;
+	for (auto& subnet : mSubnets) {
+		for (auto& node : subnet.nodes) {
+			UInt idx = static_cast<UInt>(names.size());
+			names.push_back(node->name());
+			if (!isVectorLogNode(idx, node->name()))
+				continue;
+
+			auto indices = node->matrixNodeIndices();
+			for (UInt phase = 0; phase < indices.size(); phase++) {
+				String name = node->name();
+				if (indices.size() > 1)
+					name += phases[phase];
+
+				UInt row = subnet.sysOff + indices[phase];
+				if (subnet.mCmplOff == 0) {
+					mVectorLogRows.push_back(row);
+					mVectorLogColumns.push_back(name);
+					continue;
+				}
+				mVectorLogRows.push_back(row);
+				mVectorLogColumns.push_back(name + ".re");
+				mVectorLogRows.push_back(row + subnet.mCmplOff);
+				mVectorLogColumns.push_back(name + ".im");
+			}
+		}
+	}
+	checkVectorLogNodes(names);
+
+	mLeftVectorLog = std::make_shared<DataLogger>(mName + "_LeftVector");
+	mRightVectorLog = std::make_shared<DataLogger>(mName + "_RightVector");
+	mLeftVectorLog->setColumnNames(mVectorLogColumns);
+	mRightVectorLog->setColumnNames(mVectorLogColumns);
+}
+
+template <typename VarType>
+void DiakopticsSolver<VarType>::logVectors(Real time, const Matrix& leftValues, const Matrix& rightValues) {
+	mLeftVectorLog->logDataLine(time, leftValues);
+	mRightVectorLog->logDataLine(time, rightValues);
 }
 
 template <typename VarType>
 void DiakopticsSolver<VarType>::LogTask::execute(Real time, Int timeStepCount) {
-	mSolver.log(time);
+	mSolver.log(time, timeStepCount);
+}
+
+template <typename VarType>
+void DiakopticsSolver<VarType>::LogTask::setBufferSize(UInt size) {
+	mLogged.assign(size, false);
+	mTimes.resize(size);
+	mLeftVectors.resize(size);
+	mRightVectors.resize(size);
+}
+
+template <typename VarType>
+void DiakopticsSolver<VarType>::LogTask::snapshot(Real time, Int timeStepCount, UInt slot) {
+	mLogged[slot] = mSolver.isVectorLogStep(timeStepCount);
+	if (!mLogged[slot])
+		return;
+	mTimes[slot] = time;
+	mSolver.gatherVectorLogRows(mSolver.mLeftSideVector, mLeftVectors[slot]);
+	mSolver.gatherVectorLogRows(mSolver.mRightSideVector, mRightVectors[slot]);
+}
+
+template <typename VarType>
+void DiakopticsSolver<VarType>::LogTask::process(UInt slot) {
+	if (mLogged[slot])
+		mSolver.logVectors(mTimes[slot], mLeftVectors[slot], mRightVectors[slot]);
 }
 
 template class DiakopticsSolver<Real>;
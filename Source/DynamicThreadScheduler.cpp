@@ -0,0 +1,121 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim/DynamicThreadScheduler.h>
+
+using namespace CPS;
+using namespace DPsim;
+
+DynamicThreadScheduler::DynamicThreadScheduler(Int threads, String outMeasurementFile) :
+	mNumThreads(threads), mOutMeasurementFile(outMeasurementFile),
+	mStartBarrier(threads), mEndBarrier(threads), mPendingTasks(0) {
+	if (threads < 1)
+		throw SchedulingException();
+}
+
+DynamicThreadScheduler::~DynamicThreadScheduler() {
+	if (!mThreads.empty() && !mJoining)
+		stop();
+}
+
+void DynamicThreadScheduler::createSchedule(const Task::List& tasks, const Edges& inEdges, const Edges& outEdges) {
+	Scheduler::compileGraph(tasks, inEdges, outEdges, mGraph);
+	Scheduler::initMeasurements(mGraph.tasks(), !mOutMeasurementFile.empty());
+
+	mPendingInDegrees.reset(new std::atomic<Int>[mGraph.size()]);
+	initReadyTasks();
+
+	configureThread(0);
+	for (Int i = 1; i < mNumThreads; i++)
+		mThreads.emplace_back(threadFunction, this, i);
+	try {
+		for (Int i = 1; i < mNumThreads; i++)
+			configureThread(i, &mThreads[i-1]);
+	}
+	catch (...) {
+		stop();
+		throw;
+	}
+}
+
+void DynamicThreadScheduler::step(Real time, Int timeStepCount) {
+	mTime = time;
+	mTimeStepCount = timeStepCount;
+
+	// Reset the dependency counters and distribute
+	// the tasks without predecessors over all threads
+	Int thread = 0;
+	auto& inDegrees = mGraph.inDegrees();
+	for (Int idx = 0; idx < mGraph.size(); idx++) {
+		mPendingInDegrees[idx].store(inDegrees[idx], std::memory_order_relaxed);
+		if (inDegrees[idx] == 0) {
+			pushReadyTask(thread, idx);
+			thread = (thread + 1) % mNumThreads;
+		}
+	}
+	mPendingTasks.store(mGraph.size(), std::memory_order_relaxed);
+
+	mStartBarrier.wait();
+	doStep(0);
+	mEndBarrier.wait();
+}
+
+void DynamicThreadScheduler::stop() {
+	if (!mThreads.empty()) {
+		mJoining = true;
+		mStartBarrier.wait();
+		for (auto& thread : mThreads)
+			thread.join();
+		mThreads.clear();
+	}
+	if (!mOutMeasurementFile.empty())
+		writeMeasurements(mOutMeasurementFile);
+}
+
+void DynamicThreadScheduler::threadFunction(DynamicThreadScheduler* sched, Int idx) {
+	while (true) {
+		sched->mStartBarrier.wait();
+		if (sched->mJoining)
+			return;
+
+		sched->doStep(idx);
+		sched->mEndBarrier.wait();
+	}
+}
+
+void DynamicThreadScheduler::doStep(Int thread) {
+	Int task;
+	Int idle = 0;
+	while (mPendingTasks.load(std::memory_order_acquire) > 0) {
+		if (!popReadyTask(thread, task)) {
+			// Give other threads on the same core a chance
+			// if the dependencies take longer to resolve
+			if (++idle % 64 == 0)
+				std::this_thread::yield();
+			else
+				AdaptiveWait::relax();
+			continue;
+		}
+		idle = 0;
+
+		if (mOutMeasurementFile.empty()) {
+			mGraph.task(task)->execute(mTime, mTimeStepCount);
+		} else {
+			auto start = std::chrono::steady_clock::now();
+			mGraph.task(task)->execute(mTime, mTimeStepCount);
+			auto end = std::chrono::steady_clock::now();
+			updateMeasurement(mGraph.task(task), end-start);
+		}
+
+		for (auto after = mGraph.successorsBegin(task); after != mGraph.successorsEnd(task); ++after) {
+			if (mPendingInDegrees[*after].fetch_sub(1, std::memory_order_acq_rel) == 1)
+				pushReadyTask(thread, *after);
+		}
+		mPendingTasks.fetch_sub(1, std::memory_order_acq_rel);
+	}
+}
@@ -0,0 +1,56 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <algorithm>
+#include <deque>
+
+#include <dpsim/GraphOrdering.h>
+
+using namespace DPsim;
+
+std::vector<UInt> GraphOrdering::reverseCuthillMcKee(const Graph& graph) {
+	std::vector<UInt> order;
+	std::vector<Bool> visited(graph.size(), false);
+
+	while (order.size() < graph.size()) {
+		// Start each connected component at an unvisited vertex of minimum degree
+		UInt start = 0;
+		Bool found = false;
+		for (UInt v = 0; v < graph.size(); v++) {
+			if (!visited[v] && (!found || graph[v].size() < graph[start].size())) {
+				start = v;
+				found = true;
+			}
+		}
+
+		std::deque<UInt> queue = { start };
+		visited[start] = true;
+		while (!queue.empty()) {
+			UInt v = queue.front();
+			queue.pop_front();
+			order.push_back(v);
+
+			// Visit neighbors in order of increasing degree
+			std::vector<UInt> neighbors;
+			for (auto n : graph[v]) {
+				if (!visited[n])
+					neighbors.push_back(n);
+			}
+			std::stable_sort(neighbors.begin(), neighbors.end(), [&graph](UInt a, UInt b) {
+				return graph[a].size() < graph[b].size();
+			});
+			for (auto n : neighbors) {
+				visited[n] = true;
+				queue.push_back(n);
+			}
+		}
+	}
+
+	std::reverse(order.begin(), order.end());
+	return order;
+}
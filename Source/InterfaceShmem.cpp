@@ -99,49 +99,47 @@ void InterfaceShmem::readValues(bool blocking) {
 }
 
 void InterfaceShmem::writeValues() {
+	writeSample(prepareSample());
+}
+
+InterfaceShmem::Sample* InterfaceShmem::prepareSample() {
 	Sample *sample = nullptr;
-	Int ret = 0;
-	bool done = false;
-	try {
-		if (shmem_int_alloc(&mShmem, &sample, 1) < 1) {
-			mLog->error("Fatal error: pool underrun in: {} <-> {} at sequence no {}", mWName, mRName, mSequence);
-			close();
-			std::exit(1);
-		}
+	if (shmem_int_alloc(&mShmem, &sample, 1) < 1) {
+		mLog->error("Fatal error: pool underrun in: {} <-> {} at sequence no {}", mWName, mRName, mSequence);
+		close();
+		std::exit(1);
+	}
 
+	try {
 		for (auto exp : mExports) {
 			exp(sample);
 		}
-
-		sample->sequence = mSequence++;
-		sample->flags |= (int) SampleFlags::HAS_DATA;
-		clock_gettime(CLOCK_REALTIME, &sample->ts.origin);
-		done = true;
-
-		do {
-			ret = shmem_int_write(&mShmem, &sample, 1);
-		} while (ret == 0);
-		if (ret < 0)
-			mLog->error("Failed to write samples to InterfaceShmem");
-
-		sample_copy(mLastSample, sample);
 	}
 	catch (std::exception& exc) {
-		/* We need to at least send something, so determine where exactly the
-		 * timer expired and either resend the last successfully sent sample or
-		 * just try to send this one again.
+		/* We need to at least send something, so resend the last
+		 * successfully sent sample.
 		 * TODO: can this be handled better? */
-		if (!done)
-			sample = mLastSample;
+		sample_decref(sample);
+		return mLastSample;
+	}
 
-		while (ret == 0)
-			ret = shmem_int_write(&mShmem, &sample, 1);
+	sample->sequence = mSequence++;
+	sample->flags |= (int) SampleFlags::HAS_DATA;
+	clock_gettime(CLOCK_REALTIME, &sample->ts.origin);
 
-		if (ret < 0)
-			mLog->error("Failed to write samples to InterfaceShmem");
+	return sample;
+}
 
-		/* Don't throw here, because we managed to send something */
-	}
+void InterfaceShmem::writeSample(Sample* sample) {
+	Int ret = 0;
+	do {
+		ret = shmem_int_write(&mShmem, &sample, 1);
+	} while (ret == 0);
+	if (ret < 0)
+		mLog->error("Failed to write samples to InterfaceShmem");
+
+	if (sample != mLastSample)
+		sample_copy(mLastSample, sample);
 }
 
 void InterfaceShmem::PreStep::execute(Real time, Int timeStepCount) {
@@ -154,6 +152,19 @@ void InterfaceShmem::PostStep::execute(Real time, Int timeStepCount) {
 		mIntf.writeValues();
 }
 
+void InterfaceShmem::PostStep::setBufferSize(UInt size) {
+	mSamples.assign(size, nullptr);
+}
+
+void InterfaceShmem::PostStep::snapshot(Real time, Int timeStepCount, UInt slot) {
+	mSamples[slot] = timeStepCount % mIntf.mDownsampling == 0 ? mIntf.prepareSample() : nullptr;
+}
+
+void InterfaceShmem::PostStep::process(UInt slot) {
+	if (mSamples[slot])
+		mIntf.writeSample(mSamples[slot]);
+}
+
 Attribute<Int>::Ptr InterfaceShmem::importInt(UInt idx) {
 	Attribute<Int>::Ptr attr = Attribute<Int>::make(Flags::read | Flags::write);
 	auto& log = mLog;
@@ -0,0 +1,175 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <algorithm>
+#include <set>
+
+#include <dpsim/LevelScheduledLU.h>
+
+using namespace CPS;
+using namespace DPsim;
+
+void LevelScheduledLU::analyze(const OrderedSparseLU& lu, const SparseMatrix& systemMatrix, Int numThreads) {
+	mNumThreads = numThreads;
+	Int n = static_cast<Int>(lu.rows());
+
+	// Eigen does not provide access to the factors of its sparse LU, only to
+	// the row and column permutations. These determine the pivots, so that the
+	// factors are recomputed without pivoting from the permuted system matrix.
+	mRowPermutation = lu.rowsPermutation();
+	mColPermutation = lu.colsPermutation();
+	SparseMatrixRow permuted = (mRowPermutation * systemMatrix) * mColPermutation.inverse();
+
+	std::vector<Eigen::Triplet<Real>> lower, upper;
+	// Off-diagonal entries of the rows of U computed so far
+	std::vector< std::vector< std::pair<Int, Real> > > upperRows(n);
+	mUpperDiagonal = Matrix::Zero(n, 1);
+	std::vector<Real> work(n, 0);
+	std::set<Int> pattern;
+	for (Int row = 0; row < n; row++) {
+		for (SparseMatrixRow::InnerIterator it(permuted, row); it; ++it) {
+			work[it.col()] = it.value();
+			pattern.insert(static_cast<Int>(it.col()));
+		}
+
+		// Eliminate the entries left of the diagonal in increasing column
+		// order. Fill-in is inserted right of the eliminated column.
+		auto col = pattern.begin();
+		while (col != pattern.end() && *col < row) {
+			Real factor = work[*col] / mUpperDiagonal(*col, 0);
+			lower.emplace_back(row, *col, factor);
+			for (auto& entry : upperRows[*col]) {
+				pattern.insert(entry.first);
+				work[entry.first] -= factor * entry.second;
+			}
+			work[*col] = 0;
+			col = pattern.erase(col);
+		}
+
+		for (; col != pattern.end(); ++col) {
+			if (*col == row)
+				mUpperDiagonal(row, 0) = work[*col];
+			else {
+				upperRows[row].emplace_back(*col, work[*col]);
+				upper.emplace_back(row, *col, work[*col]);
+			}
+			work[*col] = 0;
+		}
+		pattern.clear();
+
+		if (mUpperDiagonal(row, 0) == 0.)
+			throw SolverException();
+	}
+
+	mLower.resize(n, n);
+	mLower.setFromTriplets(lower.begin(), lower.end());
+	mLower.prune(0.0);
+	mUpper.resize(n, n);
+	mUpper.setFromTriplets(upper.begin(), upper.end());
+	mUpper.prune(0.0);
+
+	// Rows of L depend on rows with smaller index, rows of U on rows with larger index
+	std::vector<Int> rowLevels(n, 0);
+	Int numLevels = 0;
+	for (Int row = 0; row < n; row++) {
+		for (SparseMatrixRow::InnerIterator it(mLower, row); it; ++it)
+			rowLevels[row] = std::max(rowLevels[row], rowLevels[it.col()] + 1);
+		numLevels = std::max(numLevels, rowLevels[row] + 1);
+	}
+	computeSegments(rowLevels, numLevels, mLowerRows, mLowerSegments);
+
+	std::fill(rowLevels.begin(), rowLevels.end(), 0);
+	numLevels = 0;
+	for (Int row = n - 1; row >= 0; row--) {
+		for (SparseMatrixRow::InnerIterator it(mUpper, row); it; ++it)
+			rowLevels[row] = std::max(rowLevels[row], rowLevels[it.col()] + 1);
+		numLevels = std::max(numLevels, rowLevels[row] + 1);
+	}
+	computeSegments(rowLevels, numLevels, mUpperRows, mUpperSegments);
+
+	mWork = Matrix::Zero(n, 1);
+}
+
+void LevelScheduledLU::computeSegments(const std::vector<Int>& rowLevels, Int numLevels,
+	std::vector<Int>& rows, std::vector<Segment>& segments) {
+
+	std::vector<Int> levelPtr(numLevels + 1, 0);
+	for (auto level : rowLevels)
+		levelPtr[level + 1]++;
+	for (Int level = 0; level < numLevels; level++)
+		levelPtr[level + 1] += levelPtr[level];
+
+	rows.resize(rowLevels.size());
+	std::vector<Int> next(levelPtr.begin(), levelPtr.end() - 1);
+	for (Int row = 0; row < static_cast<Int>(rowLevels.size()); row++)
+		rows[next[rowLevels[row]]++] = row;
+
+	// Consecutive small levels are merged into one segment, which
+	// is computed in level order by the first thread
+	segments.clear();
+	for (Int level = 0; level < numLevels; level++) {
+		Bool parallel = mNumThreads > 1
+			&& levelPtr[level + 1] - levelPtr[level] >= mNumThreads * mMinRowsPerThread;
+		if (!parallel && !segments.empty() && !segments.back().parallel)
+			segments.back().end = levelPtr[level + 1];
+		else
+			segments.push_back({ levelPtr[level], levelPtr[level + 1], parallel });
+	}
+}
+
+void LevelScheduledLU::prepare(const Matrix& rightSideVector) {
+	mWork = mRowPermutation * rightSideVector;
+}
+
+void LevelScheduledLU::solveThread(Int thread, Barrier& barrier) {
+	// Forward substitution with unit lower triangular factor
+	for (auto& segment : mLowerSegments) {
+		Int begin = segment.begin, end = segment.end;
+		if (segment.parallel) {
+			begin = segment.begin + (segment.end - segment.begin) * thread / mNumThreads;
+			end = segment.begin + (segment.end - segment.begin) * (thread + 1) / mNumThreads;
+		}
+		else if (thread != 0) {
+			begin = end;
+		}
+
+		for (Int idx = begin; idx < end; idx++) {
+			Int row = mLowerRows[idx];
+			Real sum = mWork(row, 0);
+			for (SparseMatrixRow::InnerIterator it(mLower, row); it; ++it)
+				sum -= it.value() * mWork(it.col(), 0);
+			mWork(row, 0) = sum;
+		}
+		barrier.wait();
+	}
+
+	// Backward substitution with upper triangular factor
+	for (auto& segment : mUpperSegments) {
+		Int begin = segment.begin, end = segment.end;
+		if (segment.parallel) {
+			begin = segment.begin + (segment.end - segment.begin) * thread / mNumThreads;
+			end = segment.begin + (segment.end - segment.begin) * (thread + 1) / mNumThreads;
+		}
+		else if (thread != 0) {
+			begin = end;
+		}
+
+		for (Int idx = begin; idx < end; idx++) {
+			Int row = mUpperRows[idx];
+			Real sum = mWork(row, 0);
+			for (SparseMatrixRow::InnerIterator it(mUpper, row); it; ++it)
+				sum -= it.value() * mWork(it.col(), 0);
+			mWork(row, 0) = sum / mUpperDiagonal(row, 0);
+		}
+		barrier.wait();
+	}
+}
+
+void LevelScheduledLU::finish(Matrix& leftSideVector) {
+	leftSideVector = mColPermutation.inverse() * mWork;
+}
@@ -7,8 +7,11 @@
  *********************************************************************************/
 
 
+#include <chrono>
+
 #include <dpsim/MNASolver.h>
 #include <dpsim/SequentialScheduler.h>
+#include <dpsim/GraphOrdering.h>
 
 using namespace DPsim;
 using namespace CPS;
@@ -18,10 +21,6 @@ namespace DPsim {
 template <typename VarType>
 MnaSolver<VarType>::MnaSolver(String name, CPS::Domain domain, CPS::Logger::Level logLevel) :
 	Solver(name, logLevel), mDomain(domain) {
-
-	// Raw source and solution vector logging
-	mLeftVectorLog = std::make_shared<DataLogger>(name + "_LeftVector", logLevel != CPS::Logger::Level::off);
-	mRightVectorLog = std::make_shared<DataLogger>(name + "_RightVector", logLevel != CPS::Logger::Level::off);
 }
 
 template <typename VarType>
@@ -53,6 +52,11 @@ void MnaSolver<VarType>::initialize() {
 	createEmptyVectors();
 	createEmptySystemMatrix();
 
+	// Open the vector logs before the first step so that neither the
+	// simulation loop nor steady-state initialization touches the filesystem
+	if (mVectorLogDownsampling > 0)
+		initializeVectorLogging();
+
 	// Register attribute for solution vector
 	if (mFrequencyParallel) {
 		mSLog->info("Computing network harmonics in parallel.");
@@ -64,6 +68,9 @@ void MnaSolver<VarType>::initialize() {
 	else {
 		addAttribute<Matrix>("left_vector", &mLeftSideVector, Flags::read);
 	}
+	addAttribute<Int>("switch_cache_hits", &mSwitchCacheHits, Flags::read);
+	addAttribute<Int>("switch_cache_misses", &mSwitchCacheMisses, Flags::read);
+	addAttribute<Real>("factorization_time", &mFactorizationTime, Flags::read);
 
 	// Initialize components from powerflow solution and
 	// calculate MNA specific initialization values.
@@ -85,7 +92,13 @@ void MnaSolver<VarType>::initialize() {
 	}
 
 	// Initialize system matrices and source vector.
-	initializeSystem();
+	auto start = std::chrono::steady_clock::now();
+	if (mFactorizeSystem)
+		initializeSystem();
+	else
+		initializeSystemWithSharedFactorization();
+	std::chrono::duration<Real> factorizationTime = std::chrono::steady_clock::now() - start;
+	mFactorizationTime = factorizationTime.count();
 
 	mSLog->info("--- Initialization finished ---");
 	mSLog->info("--- Initial system matrices and vectors ---");
@@ -94,6 +107,18 @@ void MnaSolver<VarType>::initialize() {
 	mSLog->flush();
 }
 
+template <>
+Bool MnaSolver<Real>::isComplexSparseSolveEnabled() {
+	return false;
+}
+
+template <>
+Bool MnaSolver<Complex>::isComplexSparseSolveEnabled() {
+	// Harmonics and low-rank updates operate on the split system
+	return mComplexSparseSolve && !mFrequencyParallel
+		&& mNumHarmMatrixNodeIndices == 0 && !isSwitchLowRankUpdateEnabled();
+}
+
 template <>
 void MnaSolver<Real>::initializeComponents() {
 	mSLog->info("-- Initialize components from power flow");
@@ -106,15 +131,12 @@ void MnaSolver<Real>::initializeComponents() {
 
 	// Initialize signal components.
 	for (auto comp : mSimSignalComps)
-		comp->initialize(mSystem.mSystemOmega, mTimeStep);
+		comp->initialize(mSystem.mSystemOmega, mTimeStep * comp->rateDivisor());
 
 	// Initialize MNA specific parts of components.
 	for (auto comp : mMNAComponents) {
 		comp->mnaInitialize(mSystem.mSystemOmega, mTimeStep, attribute<Matrix>("left_vector"));
-		const Matrix& stamp = comp->template attribute<Matrix>("right_vector")->get();
-		if (stamp.size() != 0) {
-			mRightVectorStamps.push_back(&stamp);
-		}
+		addRightVectorStamp(comp);
 	}
 	for (auto comp : mSwitches)
 		comp->mnaInitialize(mSystem.mSystemOmega, mTimeStep, attribute<Matrix>("left_vector"));
@@ -134,7 +156,7 @@ void MnaSolver<Complex>::initializeComponents() {
 
 	// Initialize signal components.
 	for (auto comp : mSimSignalComps)
-		comp->initialize(mSystem.mSystemOmega, mTimeStep);
+		comp->initialize(mSystem.mSystemOmega, mTimeStep * comp->rateDivisor());
 
 	mSLog->info("-- Initialize MNA properties of components");
 	if (mFrequencyParallel) {
@@ -142,8 +164,7 @@ void MnaSolver<Complex>::initializeComponents() {
 		for (auto comp : mMNAComponents) {
 			// Initialize MNA specific parts of components.
 			comp->mnaInitializeHarm(mSystem.mSystemOmega, mTimeStep, mLeftVectorHarmAttributes);
-			const Matrix& stamp = comp->template attribute<Matrix>("right_vector")->get();
-			if (stamp.size() != 0) mRightVectorStamps.push_back(&stamp);
+			addRightVectorStamp(comp);
 		}
 		// Initialize nodes
 		for (UInt nodeIdx = 0; nodeIdx < mNodes.size(); nodeIdx++) {
@@ -154,16 +175,33 @@ void MnaSolver<Complex>::initializeComponents() {
 		// Initialize MNA specific parts of components.
 		for (auto comp : mMNAComponents) {
 			comp->mnaInitialize(mSystem.mSystemOmega, mTimeStep, attribute<Matrix>("left_vector"));
-			const Matrix& stamp = comp->template attribute<Matrix>("right_vector")->get();
-			if (stamp.size() != 0) {
-				mRightVectorStamps.push_back(&stamp);
-			}
+			addRightVectorStamp(comp);
 		}
 		for (auto comp : mSwitches)
 			comp->mnaInitialize(mSystem.mSystemOmega, mTimeStep, attribute<Matrix>("left_vector"));
 	}
 }
 
+template <typename VarType>
+void MnaSolver<VarType>::addRightVectorStamp(CPS::MNAInterface::Ptr comp) {
+	const RightVectorStamp& stamp = comp->template attribute<RightVectorStamp>("right_vector")->get();
+	if (stamp.size() != 0)
+		mRightVectorStamps.push_back(&stamp);
+}
+
+template <typename VarType>
+void MnaSolver<VarType>::addRightVectorStamps() {
+	for (auto stamp : mRightVectorStamps)
+		stamp->addTo(mRightSideVector);
+}
+
+template <typename VarType>
+void MnaSolver<VarType>::stampRightSideVector(CPS::MNAInterface::Ptr comp) {
+	RightVectorStamp stamp(mRightSideVector.rows());
+	comp->mnaApplyRightSideVectorStamp(stamp);
+	stamp.addTo(mRightSideVector);
+}
+
 template <typename VarType>
 void MnaSolver<VarType>::initializeSystem() {
 	mSLog->info("-- Initialize MNA system matrices and source vector");
@@ -177,6 +215,10 @@ void MnaSolver<VarType>::initializeSystem() {
 
 	if (mFrequencyParallel)
 		initializeSystemWithParallelFrequencies();
+	else if (isSwitchLowRankUpdateEnabled())
+		initializeSystemWithLowRankUpdates();
+	else if (isSwitchCacheEnabled())
+		initializeSystemWithSwitchCache();
 	else
 		initializeSystemWithPrecomputedMatrices();
 }
@@ -209,6 +251,9 @@ void MnaSolver<VarType>::initializeSystemWithPrecomputedMatrices() {
 	// iterate over all possible switch state combinations
 	for (std::size_t i = 0; i < (1ULL << mSwitches.size()); i++) {
 		mSwitchedMatrices[std::bitset<SWITCH_NUM>(i)].setZero();
+#ifdef WITH_SPARSE
+		reserveSystemMatrix(mSwitchedMatrices[std::bitset<SWITCH_NUM>(i)]);
+#endif
 	}
 
 	if (mSwitches.size() < 1) {
@@ -223,12 +268,7 @@ void MnaSolver<VarType>::initializeSystemWithPrecomputedMatrices() {
 					Logger::matrixToString(mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)]));
 			}
 		}
-#ifdef WITH_SPARSE
-		mLuFactorizations[std::bitset<SWITCH_NUM>(0)].analyzePattern(mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)]);
-		mLuFactorizations[std::bitset<SWITCH_NUM>(0)].factorize(mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)]);
-#else
-		mLuFactorizations[std::bitset<SWITCH_NUM>(0)] = Eigen::PartialPivLU<Matrix>(mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)]);
-#endif
+		factorizeSystemMatrix(std::bitset<SWITCH_NUM>(0), CPS::Logger::Level::info);
 	}
 	else {
 		// Generate switching state dependent system matrices
@@ -238,12 +278,7 @@ void MnaSolver<VarType>::initializeSystemWithPrecomputedMatrices() {
 			for (UInt i = 0; i < mSwitches.size(); i++)
 				mSwitches[i]->mnaApplySwitchSystemMatrixStamp(sys.second, sys.first[i]);
 			// Compute LU-factorization for system matrix
-#ifdef WITH_SPARSE
-			mLuFactorizations[sys.first].analyzePattern(sys.second);
-			mLuFactorizations[sys.first].factorize(sys.second);
-#else
-			mLuFactorizations[sys.first] = Eigen::PartialPivLU<Matrix>(sys.second);
-#endif
+			factorizeSystemMatrix(sys.first, CPS::Logger::Level::info);
 		}
 		updateSwitchStatus();
 	}
@@ -253,7 +288,7 @@ void MnaSolver<VarType>::initializeSystemWithPrecomputedMatrices() {
 	// as not full pre-step is executed (not involving necessary electrical or signal 
 	// subcomp updates before right vector calculation)
 	for (auto comp : mMNAComponents) {
-		comp->mnaApplyRightSideVectorStamp(mRightSideVector);
+		stampRightSideVector(comp);
 		auto idObj = std::dynamic_pointer_cast<IdentifiedObject>(comp);
 		mSLog->debug("Stamping {:s} {:s} into source vector",
 			idObj->type(), idObj->name());
@@ -262,6 +297,349 @@ void MnaSolver<VarType>::initializeSystemWithPrecomputedMatrices() {
 	}
 }
 
+template <typename VarType>
+void MnaSolver<VarType>::initializeSystemWithSwitchCache() {
+	mSLog->info("Factorize switch configurations on demand, cache size: {:d}", mSwitchCacheSize);
+	mSwitchedMatrices.clear();
+	mLuFactorizations.clear();
+	mSwitchCacheOrder.clear();
+	mSwitchCacheEntries.clear();
+	mSwitchCacheHits = 0;
+	mSwitchCacheMisses = 0;
+
+	// Static components are stamped only once into the base matrix.
+	// The switches are added for each configuration that is requested.
+	stampBaseSystemMatrix();
+	updateSwitchStatus();
+	updateSwitchCache();
+
+	// Initialize source vector for debugging
+	for (auto comp : mMNAComponents)
+		stampRightSideVector(comp);
+}
+
+template <typename VarType>
+void MnaSolver<VarType>::initializeSystemWithLowRankUpdates() {
+	mSLog->info("Apply switching as low-rank updates, maximum rank: {:d}", mSwitchMaxUpdateRank);
+	mSwitchedMatrices.clear();
+	mLuFactorizations.clear();
+
+	stampBaseSystemMatrix();
+
+	// The change of each switch is the difference between its closed
+	// and its open stamp. This is usually a rank-1 update.
+	mSwitchDeltaMatrices.clear();
+	for (auto sw : mSwitches) {
+		SparseMatrix closed(mBaseSystemMatrix.rows(), mBaseSystemMatrix.cols());
+		SparseMatrix open(mBaseSystemMatrix.rows(), mBaseSystemMatrix.cols());
+		sw->mnaApplySwitchSystemMatrixStamp(closed, true);
+		sw->mnaApplySwitchSystemMatrixStamp(open, false);
+		SparseMatrix delta = closed - open;
+		delta.prune(0.0);
+		mSwitchDeltaMatrices.push_back(delta);
+	}
+
+	updateSwitchStatus();
+	factorizeSwitchConfiguration(mCurrentSwitchStatus);
+	mLowRankBaseStatus = mCurrentSwitchStatus;
+	mLowRankUpdateStatus = mCurrentSwitchStatus;
+	mLowRankRows.clear();
+	mLowRankCols.clear();
+
+	// Initialize source vector for debugging
+	for (auto comp : mMNAComponents)
+		stampRightSideVector(comp);
+}
+
+template <typename VarType>
+void MnaSolver<VarType>::initializeSystemWithSharedFactorization() {
+	mSLog->info("-- Initialize source vector, system matrices are factorized by another solver");
+
+	// Release the matrices of the steady-state initialization
+	mSwitchedMatrices.clear();
+	mLuFactorizations.clear();
+	mLuFactorizationsComp.clear();
+
+	mRightSideVector.setZero();
+	updateSwitchStatus();
+	for (auto comp : mMNAComponents)
+		stampRightSideVector(comp);
+}
+
+template <typename VarType>
+void MnaSolver<VarType>::stampSystemMatrix(MAT_TYPE& systemMatrix, std::bitset<SWITCH_NUM> status) {
+#ifdef WITH_SPARSE
+	systemMatrix.resize(mBaseSystemMatrix.rows(), mBaseSystemMatrix.cols());
+	reserveSystemMatrix(systemMatrix);
+#else
+	systemMatrix = Matrix::Zero(mBaseSystemMatrix.rows(), mBaseSystemMatrix.cols());
+#endif
+	for (auto comp : mMNAComponents)
+		comp->mnaApplySystemMatrixStamp(systemMatrix);
+	for (UInt i = 0; i < mSwitches.size(); i++)
+		mSwitches[i]->mnaApplySwitchSystemMatrixStamp(systemMatrix, status[i]);
+#ifdef WITH_SPARSE
+	systemMatrix.makeCompressed();
+#endif
+}
+
+template <typename VarType>
+void MnaSolver<VarType>::updateLowRankCorrection() {
+	mLowRankUpdateStatus = mCurrentSwitchStatus;
+
+	// Sum up the changes of all switches that differ from the base configuration
+	SparseMatrix delta(mBaseSystemMatrix.rows(), mBaseSystemMatrix.cols());
+	for (UInt i = 0; i < mSwitches.size(); i++) {
+		if (mCurrentSwitchStatus[i] == mLowRankBaseStatus[i])
+			continue;
+		if (mCurrentSwitchStatus[i])
+			delta += mSwitchDeltaMatrices[i];
+		else
+			delta -= mSwitchDeltaMatrices[i];
+	}
+	delta.prune(0.0);
+
+	// Collect changed rows and columns
+	std::vector<Int> colIdx(delta.cols(), -1);
+	mLowRankRows.clear();
+	mLowRankCols.clear();
+	for (Int row = 0; row < delta.outerSize(); row++) {
+		for (SparseMatrix::InnerIterator it(delta, row); it; ++it) {
+			if (mLowRankRows.empty() || mLowRankRows.back() != (UInt) row)
+				mLowRankRows.push_back(row);
+			if (colIdx[it.col()] < 0) {
+				colIdx[it.col()] = (Int) mLowRankCols.size();
+				mLowRankCols.push_back(it.col());
+			}
+		}
+	}
+
+	if (mLowRankRows.empty())
+		return;
+
+	// The changed entries as dense block D. A switch between two nodes changes
+	// two rows, but only adds a rank-1 update. D is therefore factorized as
+	// D = L R^T with the numerical rank of D as inner dimension.
+	Matrix changed = Matrix::Zero(mLowRankRows.size(), mLowRankCols.size());
+	for (UInt r = 0; r < mLowRankRows.size(); r++) {
+		for (SparseMatrix::InnerIterator it(delta, mLowRankRows[r]); it; ++it)
+			changed(r, colIdx[it.col()]) = it.value();
+	}
+	Eigen::JacobiSVD<Matrix> svd(changed, Eigen::ComputeThinU | Eigen::ComputeThinV);
+	UInt rank = static_cast<UInt>(svd.rank());
+
+	// Refactorize and use the current configuration as new base
+	// if the update becomes too expensive
+	if (rank > mSwitchMaxUpdateRank) {
+		mSLog->info("Rank of switch update {:d} exceeds limit, refactorize system matrix", rank);
+		mSwitchedMatrices.erase(mLowRankBaseStatus);
+		mLuFactorizations.erase(mLowRankBaseStatus);
+		factorizeSwitchConfiguration(mCurrentSwitchStatus);
+		mLowRankBaseStatus = mCurrentSwitchStatus;
+		mLowRankRows.clear();
+		mLowRankCols.clear();
+		return;
+	}
+	if (rank == 0) {
+		mLowRankRows.clear();
+		mLowRankCols.clear();
+		return;
+	}
+
+	// Woodbury identity with A' = A + U V^T where U = E_rows L and
+	// V = E_cols R scatter the factors to the changed rows and columns:
+	// A'^-1 b = A^-1 b - Z (I + V^T Z)^-1 V^T A^-1 b, with Z = A^-1 U
+	Matrix left = svd.matrixU().leftCols(rank) * svd.singularValues().head(rank).asDiagonal();
+	mLowRankDelta = svd.matrixV().leftCols(rank).transpose();
+
+	auto& baseLu = mLuFactorizations[mLowRankBaseStatus];
+	mLowRankBaseSolutions = Matrix::Zero(mBaseSystemMatrix.rows(), rank);
+	Matrix update = Matrix::Zero(mBaseSystemMatrix.rows(), 1);
+	for (UInt k = 0; k < rank; k++) {
+		for (UInt r = 0; r < mLowRankRows.size(); r++)
+			update(mLowRankRows[r], 0) = left(r, k);
+		mLowRankBaseSolutions.col(k) = baseLu.solve(update);
+	}
+
+	Matrix selectedSolutions(mLowRankCols.size(), rank);
+	for (UInt c = 0; c < mLowRankCols.size(); c++)
+		selectedSolutions.row(c) = mLowRankBaseSolutions.row(mLowRankCols[c]);
+
+	mLowRankCapacitance = CPS::LUFactorized(
+		Matrix::Identity(rank, rank) + mLowRankDelta * selectedSolutions);
+}
+
+template <typename VarType>
+void MnaSolver<VarType>::solveWithLowRankUpdate() {
+	if (mCurrentSwitchStatus != mLowRankUpdateStatus)
+		updateLowRankCorrection();
+
+	mLeftSideVector = mLuFactorizations[mLowRankBaseStatus].solve(mRightSideVector);
+	if (mLowRankRows.empty())
+		return;
+
+	Matrix selectedSolution(mLowRankCols.size(), 1);
+	for (UInt c = 0; c < mLowRankCols.size(); c++)
+		selectedSolution(c, 0) = mLeftSideVector(mLowRankCols[c], 0);
+
+	mLeftSideVector -= mLowRankBaseSolutions *
+		mLowRankCapacitance.solve(mLowRankDelta * selectedSolution);
+}
+
+template <typename VarType>
+void MnaSolver<VarType>::stampBaseSystemMatrix() {
+	mBaseSystemMatrix.setZero();
+#ifdef WITH_SPARSE
+	reserveSystemMatrix(mBaseSystemMatrix);
+#endif
+	for (auto comp : mMNAComponents)
+		comp->mnaApplySystemMatrixStamp(mBaseSystemMatrix);
+#ifdef WITH_SPARSE
+	mBaseSystemMatrix.makeCompressed();
+#endif
+}
+
+template <typename VarType>
+void MnaSolver<VarType>::updateSwitchCache() {
+	mSwitchCacheStatus = mCurrentSwitchStatus;
+	auto entry = mSwitchCacheEntries.find(mCurrentSwitchStatus);
+	if (entry != mSwitchCacheEntries.end()) {
+		mSwitchCacheHits++;
+		// Move configuration to the front of the list
+		mSwitchCacheOrder.splice(mSwitchCacheOrder.begin(), mSwitchCacheOrder, entry->second);
+		return;
+	}
+
+	mSwitchCacheMisses++;
+	// Evict least recently used configuration
+	if (mSwitchCacheOrder.size() >= mSwitchCacheSize) {
+		auto evicted = mSwitchCacheOrder.back();
+		mSwitchCacheOrder.pop_back();
+		mSwitchCacheEntries.erase(evicted);
+		mSwitchedMatrices.erase(evicted);
+		mLuFactorizations.erase(evicted);
+		mLuFactorizationsComp.erase(evicted);
+		mLevelScheduledLUs.erase(evicted);
+		mSLog->debug("Evict switch configuration {:s}", evicted.to_string());
+	}
+
+	factorizeSwitchConfiguration(mCurrentSwitchStatus);
+	mSwitchCacheOrder.push_front(mCurrentSwitchStatus);
+	mSwitchCacheEntries[mCurrentSwitchStatus] = mSwitchCacheOrder.begin();
+}
+
+template <typename VarType>
+void MnaSolver<VarType>::factorizeSwitchConfiguration(std::bitset<SWITCH_NUM> status) {
+	mSLog->debug("Factorize system matrix for switch configuration {:s}", status.to_string());
+
+	// The level schedule is updated on its next use
+	mLevelScheduledLUs.erase(status);
+
+	auto& sys = mSwitchedMatrices[status];
+	sys = mBaseSystemMatrix;
+	for (UInt i = 0; i < mSwitches.size(); i++)
+		mSwitches[i]->mnaApplySwitchSystemMatrixStamp(sys, status[i]);
+	factorizeSystemMatrix(status, CPS::Logger::Level::debug);
+}
+
+template <typename VarType>
+void MnaSolver<VarType>::factorizeSystemMatrix(std::bitset<SWITCH_NUM> status, CPS::Logger::Level level) {
+	auto& sys = mSwitchedMatrices[status];
+#ifdef WITH_SPARSE
+	sys.makeCompressed();
+#endif
+	// The split system is only factorized if it is not solved as complex system
+	if (isComplexSparseSolveEnabled() && factorizeComplexSystem(status, level))
+		return;
+
+#ifdef WITH_SPARSE
+	analyzeSystemMatrix(mLuFactorizations[status], sys);
+	mLuFactorizations[status].factorize(sys);
+	logFactorNonZeros(mLuFactorizations[status], sys, status, level);
+#else
+	mLuFactorizations[status] = Eigen::PartialPivLU<Matrix>(sys);
+#endif
+}
+
+template <typename VarType>
+Bool MnaSolver<VarType>::factorizeComplexSystem(std::bitset<SWITCH_NUM> status, CPS::Logger::Level level) {
+	// Components stamp a complex entry a + jb at (r, c) into the split system
+	// as [a -b; b a]. The upper half of the split matrix thus contains the
+	// complete complex matrix and the lower half is redundant.
+	UInt n = mNumMatrixNodeIndices;
+#ifdef WITH_SPARSE
+	const SparseMatrix& split = mSwitchedMatrices[status];
+#else
+	SparseMatrix split = mSwitchedMatrices[status].sparseView();
+#endif
+	std::vector<Eigen::Triplet<Complex>> upper, lower;
+	for (Eigen::Index row = 0; row < split.outerSize(); row++) {
+		for (SparseMatrix::InnerIterator it(split, row); it; ++it) {
+			UInt r = static_cast<UInt>(it.row()), c = static_cast<UInt>(it.col());
+			if (r < n)
+				upper.emplace_back(r, c % n, c < n ? Complex(it.value(), 0) : Complex(0, -it.value()));
+			else
+				lower.emplace_back(r - n, c % n, c < n ? Complex(0, it.value()) : Complex(it.value(), 0));
+		}
+	}
+
+	SparseMatrixComp sys(n, n), check(n, n);
+	sys.setFromTriplets(upper.begin(), upper.end());
+	check.setFromTriplets(lower.begin(), lower.end());
+
+	// Some components stamp real and imaginary parts independently
+	if ((sys - check).norm() > 1e-9 * sys.norm()) {
+		mSLog->warn("System matrix cannot be represented as complex matrix, "
+			"solve split system instead");
+		mComplexSparseSolve = false;
+
+		// Switch configurations factorized before only have a complex factorization
+		std::vector< std::bitset<SWITCH_NUM> > factorized;
+		for (auto& lu : mLuFactorizationsComp)
+			factorized.push_back(lu.first);
+		mLuFactorizationsComp.clear();
+		for (auto& factorizedStatus : factorized)
+			factorizeSystemMatrix(factorizedStatus, level);
+		return false;
+	}
+
+	mSLog->log(level, "Factorize complex system matrix of dimension {:d} with {:d} non-zeros "
+		"(split system: {:d} non-zeros)", n, sys.nonZeros(), split.nonZeros());
+
+	sys.makeCompressed();
+	auto& lu = mLuFactorizationsComp[status];
+	analyzeSystemMatrix(lu, sys);
+	lu.factorize(sys);
+	if (lu.info() != Eigen::Success)
+		throw SolverException();
+	logFactorNonZeros(lu, sys, status, level);
+
+	mRightSideVectorComp = MatrixComp::Zero(n, 1);
+	mLeftSideVectorComp = MatrixComp::Zero(n, 1);
+	return true;
+}
+
+template <typename VarType>
+void MnaSolver<VarType>::solveComplexSystem() {
+	// Convert at the boundary to the split vectors used by the components
+	UInt n = mNumMatrixNodeIndices;
+	mRightSideVectorComp.real() = mRightSideVector.topRows(n);
+	mRightSideVectorComp.imag() = mRightSideVector.middleRows(n, n);
+	mLeftSideVectorComp = mLuFactorizationsComp[mCurrentSwitchStatus].solve(mRightSideVectorComp);
+	mLeftSideVector.topRows(n) = mLeftSideVectorComp.real();
+	mLeftSideVector.middleRows(n, n) = mLeftSideVectorComp.imag();
+}
+
+#ifdef WITH_SPARSE
+template <typename VarType>
+void MnaSolver<VarType>::reserveSystemMatrix(SparseMatrix& systemMatrix) {
+	// Components insert their entries in arbitrary order. Reserving space in
+	// every row avoids moving the whole matrix on each insertion, so that the
+	// assembly scales with the number of non-zeros.
+	systemMatrix.reserve(Eigen::VectorXi::Constant(systemMatrix.rows(), mNumStampEntriesPerRow));
+}
+#endif
+
 template <typename VarType>
 void MnaSolver<VarType>::updateSwitchStatus() {
 	for (UInt i = 0; i < mSwitches.size(); i++) {
@@ -328,6 +706,11 @@ void MnaSolver<VarType>::assignMatrixNodeIndices() {
 	mNumVirtualMatrixNodeIndices = mNumMatrixNodeIndices - mNumNetMatrixNodeIndices;
 	mNumHarmMatrixNodeIndices = static_cast<UInt>(mSystem.mFrequencies.size()-1) * mNumMatrixNodeIndices;
 
+#ifndef WITH_SPARSE
+	if (mNodeOrdering != NodeOrdering::COLAMD)
+		mSLog->warn("Node ordering is only used by sparse factorizations and is ignored");
+#endif
+
 	mSLog->info("Assigned simulation nodes to topology nodes:");
 	mSLog->info("Number of network simulation nodes: {:d}", mNumNetMatrixNodeIndices);
 	mSLog->info("Number of simulation nodes: {:d}", mNumMatrixNodeIndices);
@@ -359,13 +742,17 @@ void MnaSolver<Real>::createEmptySystemMatrix() {
 	if (mSwitches.size() > SWITCH_NUM)
 		throw SystemError("Too many Switches.");
 
+	// Matrices for switch configurations are created on demand if cached
+	std::size_t numSwitchConfigs = (isSwitchCacheEnabled() || isSwitchLowRankUpdateEnabled()) ?
+		0 : (1ULL << mSwitches.size());
+
 #ifdef WITH_SPARSE
-	for (std::size_t i = 0; i < (1ULL << mSwitches.size()); i++)
+	for (std::size_t i = 0; i < numSwitchConfigs; i++)
 		mSwitchedMatrices[std::bitset<SWITCH_NUM>(i)].resize(mNumMatrixNodeIndices, mNumMatrixNodeIndices);
 
 	mBaseSystemMatrix.resize(mNumMatrixNodeIndices, mNumMatrixNodeIndices);
 #else
-	for (std::size_t i = 0; i < (1ULL << mSwitches.size()); i++)
+	for (std::size_t i = 0; i < numSwitchConfigs; i++)
 		mSwitchedMatrices[std::bitset<SWITCH_NUM>(i)] = Matrix::Zero(mNumMatrixNodeIndices, mNumMatrixNodeIndices);
 
 	mBaseSystemMatrix = Matrix::Zero(mNumMatrixNodeIndices, mNumMatrixNodeIndices);
@@ -386,7 +773,10 @@ void MnaSolver<Complex>::createEmptySystemMatrix() {
 		}
 	}
 	else {
-		for (std::size_t i = 0; i < (1ULL << mSwitches.size()); i++) {
+		// Matrices for switch configurations are created on demand if cached
+		std::size_t numSwitchConfigs = (isSwitchCacheEnabled() || isSwitchLowRankUpdateEnabled()) ?
+			0 : (1ULL << mSwitches.size());
+		for (std::size_t i = 0; i < numSwitchConfigs; i++) {
 #ifdef WITH_SPARSE
 			mSwitchedMatrices[std::bitset<SWITCH_NUM>(i)].resize(2*(mNumMatrixNodeIndices + mNumHarmMatrixNodeIndices), 2*(mNumMatrixNodeIndices + mNumHarmMatrixNodeIndices));
 #else
@@ -444,8 +834,13 @@ template <typename VarType>
 void MnaSolver<VarType>::steadyStateInitialization() {
 	mSLog->info("--- Run steady-state initialization ---");
 
-	DataLogger initLeftVectorLog(mName + "_InitLeftVector", mLogLevel != CPS::Logger::Level::off);
-	DataLogger initRightVectorLog(mName + "_InitRightVector", mLogLevel != CPS::Logger::Level::off);
+	Bool vectorLogging = mVectorLogDownsampling > 0;
+	DataLogger initLeftVectorLog(mName + "_InitLeftVector", vectorLogging);
+	DataLogger initRightVectorLog(mName + "_InitRightVector", vectorLogging);
+	if (vectorLogging) {
+		initLeftVectorLog.setColumnNames(mVectorLogColumns);
+		initRightVectorLog.setColumnNames(mVectorLogColumns);
+	}
 
 	TopologicalPowerComp::Behaviour initBehaviourPowerComps = TopologicalPowerComp::Behaviour::Initialization;
 	SimSignalComp::Behaviour initBehaviourSignalComps = SimSignalComp::Behaviour::Initialization;
@@ -489,7 +884,7 @@ void MnaSolver<VarType>::steadyStateInitialization() {
 	}
 	// TODO signal components should be moved out of MNA solver
 	for (auto comp : mSimSignalComps) {
-		for (auto task : comp->getTasks()) {
+		for (auto task : comp->getTasksAtRate()) {
 			tasks.push_back(task);
 		}
 	}
@@ -504,13 +899,11 @@ void MnaSolver<VarType>::steadyStateInitialization() {
 
 		sched.step(time, timeStepCount);
 
-		if (mDomain == CPS::Domain::EMT) {
-			initLeftVectorLog.logEMTNodeValues(time, leftSideVector());
-			initRightVectorLog.logEMTNodeValues(time, rightSideVector());
-		}
-		else {
-			initLeftVectorLog.logPhasorNodeValues(time, leftSideVector());
-			initRightVectorLog.logPhasorNodeValues(time, rightSideVector());
+		if (isVectorLogStep(timeStepCount)) {
+			gatherVectorLogRows(leftSideVector(), mLeftVectorValues);
+			gatherVectorLogRows(rightSideVector(), mRightVectorValues);
+			initLeftVectorLog.logDataLine(time, mLeftVectorValues);
+			initRightVectorLog.logDataLine(time, mRightVectorValues);
 		}
 
 		// Calculate new simulation time
@@ -555,13 +948,16 @@ Task::List MnaSolver<VarType>::getTasks() {
 	}
 	// TODO signal components should be moved out of MNA solver
 	for (auto comp : mSimSignalComps) {
-		for (auto task : comp->getTasks()) {
+		for (auto task : comp->getTasksAtRate()) {
 			l.push_back(task);
 		}
 	}
 	if (mFrequencyParallel) {
 		for (UInt i = 0; i < mSystem.mFrequencies.size(); i++)
 			l.push_back(std::make_shared<MnaSolver<VarType>::SolveTaskHarm>(*this, i));
+	} else if (isLevelScheduledSolveEnabled()) {
+		l.push_back(std::make_shared<MnaSolver<VarType>::ParallelSolveTask>(*this));
+		l.push_back(std::make_shared<MnaSolver<VarType>::LogTask>(*this));
 	} else {
 		l.push_back(std::make_shared<MnaSolver<VarType>::SolveTask>(*this));
 		l.push_back(std::make_shared<MnaSolver<VarType>::LogTask>(*this));
@@ -576,11 +972,19 @@ void MnaSolver<VarType>::solve(Real time, Int timeStepCount) {
 
 	// Add together the right side vector (computed by the components'
 	// pre-step tasks)
-	for (auto stamp : mRightVectorStamps)
-		mRightSideVector += *stamp;
-
-	if (mSwitchedMatrices.size() > 0)
-		mLeftSideVector = mLuFactorizations[mCurrentSwitchStatus].solve(mRightSideVector);
+	addRightVectorStamps();
+
+	if (isSwitchCacheEnabled() && mCurrentSwitchStatus != mSwitchCacheStatus)
+		updateSwitchCache();
+
+	if (isSwitchLowRankUpdateEnabled())
+		solveWithLowRankUpdate();
+	else if (mSwitchedMatrices.size() > 0) {
+		if (isComplexSparseSolveEnabled())
+			solveComplexSystem();
+		else
+			mLeftSideVector = mLuFactorizations[mCurrentSwitchStatus].solve(mRightSideVector);
+	}
 
 	// TODO split into separate task? (dependent on x, updating all v attributes)
 	for (UInt nodeIdx = 0; nodeIdx < mNumNetNodes; nodeIdx++)
@@ -592,30 +996,137 @@ void MnaSolver<VarType>::solve(Real time, Int timeStepCount) {
 	// Components' states will be updated by the post-step tasks
 }
 
+template <typename VarType>
+Bool MnaSolver<VarType>::isLevelScheduledSolveEnabled() {
+#ifdef WITH_SPARSE
+	return mLevelScheduledSolve && !mFrequencyParallel
+		&& !isSwitchLowRankUpdateEnabled() && !isComplexSparseSolveEnabled();
+#else
+	return false;
+#endif
+}
+
+template <typename VarType>
+void MnaSolver<VarType>::setSolveThreads(Int numThreads, WaitMode waitMode) {
+	mSLog->info("Solve with level-scheduled substitution on {:d} threads", numThreads);
+	mSolveThreads = numThreads;
+	mSolveBarrier.reset(new Barrier(numThreads, waitMode));
+	mLevelScheduledLUs.clear();
+}
+
+template <typename VarType>
+void MnaSolver<VarType>::solveThread(Real time, Int timeStepCount, Int thread) {
+	if (thread == 0) {
+		if (!mSolveBarrier)
+			setSolveThreads(1);
+
+		mRightSideVector.setZero();
+		addRightVectorStamps();
+
+		if (isSwitchCacheEnabled() && mCurrentSwitchStatus != mSwitchCacheStatus)
+			updateSwitchCache();
+
+#ifdef WITH_SPARSE
+		auto it = mLevelScheduledLUs.find(mCurrentSwitchStatus);
+		if (it == mLevelScheduledLUs.end()) {
+			it = mLevelScheduledLUs.emplace(mCurrentSwitchStatus, LevelScheduledLU()).first;
+			it->second.analyze(mLuFactorizations[mCurrentSwitchStatus],
+				mSwitchedMatrices[mCurrentSwitchStatus], mSolveThreads);
+		}
+		mCurrentLevelScheduledLU = &it->second;
+#endif
+		mCurrentLevelScheduledLU->prepare(mRightSideVector);
+	}
+
+	// The other threads wait until the source vector is complete
+	mSolveBarrier->wait();
+	mCurrentLevelScheduledLU->solveThread(thread, *mSolveBarrier);
+	if (thread != 0)
+		return;
+
+	mCurrentLevelScheduledLU->finish(mLeftSideVector);
+
+	for (UInt nodeIdx = 0; nodeIdx < mNumNetNodes; nodeIdx++)
+		mNodes[nodeIdx]->mnaUpdateVoltage(mLeftSideVector);
+
+	if (!mIsInInitialization)
+		updateSwitchStatus();
+}
+
 template <typename VarType>
 void MnaSolver<VarType>::solveWithHarmonics(Real time, Int timeStepCount, Int freqIdx) {
 	mRightSideVectorHarm[freqIdx].setZero();
 
 	// Sum of right side vectors (computed by the components' pre-step tasks)
 	for (auto stamp : mRightVectorStamps)
-		mRightSideVectorHarm[freqIdx] += stamp->col(freqIdx);
+		stamp->addColumnTo(mRightSideVectorHarm[freqIdx], freqIdx);
 
 	mLeftSideVectorHarm[freqIdx] =	mLuFactorizationsHarm[mCurrentSwitchStatus][freqIdx].solve(mRightSideVectorHarm[freqIdx]);
 }
 
 template <typename VarType>
 void MnaSolver<VarType>::log(Real time, Int timeStepCount) {
-	if (mLogLevel == Logger::Level::off)
+	if (!isVectorLogStep(timeStepCount))
 		return;
 
-	if (mDomain == CPS::Domain::EMT) {
-		mLeftVectorLog->logEMTNodeValues(time, leftSideVector());
-		mRightVectorLog->logEMTNodeValues(time, rightSideVector());
-	}
-	else {
-		mLeftVectorLog->logPhasorNodeValues(time, leftSideVector());
-		mRightVectorLog->logPhasorNodeValues(time, rightSideVector());
+	gatherVectorLogRows(leftSideVector(), mLeftVectorValues);
+	gatherVectorLogRows(rightSideVector(), mRightVectorValues);
+	logVectors(time, mLeftVectorValues, mRightVectorValues);
+}
+
+template <typename VarType>
+void MnaSolver<VarType>::initializeVectorLogging() {
+	mVectorLogRows.clear();
+	mVectorLogColumns.clear();
+
+	// The phasor vectors hold the real parts of all nodes followed by
+	// the imaginary parts, once per frequency
+	UInt numFreqs = mDomain == CPS::Domain::EMT ? 1 : static_cast<UInt>(mSystem.mFrequencies.size());
+	UInt harmonicOffset = static_cast<UInt>(leftSideVector().rows()) / numFreqs;
+	UInt complexOffset = harmonicOffset / 2;
+	const String phases[] = { "_A", "_B", "_C" };
+
+	std::vector<String> names;
+	for (UInt idx = 0; idx < mNodes.size(); idx++) {
+		auto& node = mNodes[idx];
+		names.push_back(node->name());
+		if (!isVectorLogNode(idx, node->name()))
+			continue;
+
+		auto indices = node->matrixNodeIndices();
+		for (UInt freq = 0; freq < numFreqs; freq++) {
+			for (UInt phase = 0; phase < indices.size(); phase++) {
+				String name = node->name();
+				if (indices.size() > 1)
+					name += phases[phase];
+				if (numFreqs > 1)
+					name += "_f" + std::to_string(freq);
+
+				UInt row = indices[phase] + harmonicOffset * freq;
+				if (mDomain == CPS::Domain::EMT) {
+					mVectorLogRows.push_back(row);
+					mVectorLogColumns.push_back(name);
+					continue;
+				}
+				mVectorLogRows.push_back(row);
+				mVectorLogColumns.push_back(name + ".re");
+				mVectorLogRows.push_back(row + complexOffset);
+				mVectorLogColumns.push_back(name + ".im");
+			}
+		}
 	}
+	checkVectorLogNodes(names);
+
+	mLeftVectorLog = std::make_shared<DataLogger>(mName + "_LeftVector");
+	mRightVectorLog = std::make_shared<DataLogger>(mName + "_RightVector");
+	mLeftVectorLog->setColumnNames(mVectorLogColumns);
+	mRightVectorLog->setColumnNames(mVectorLogColumns);
+}
+
+template <typename VarType>
+void MnaSolver<VarType>::logVectors(Real time, const Matrix& leftValues, const Matrix& rightValues) {
+	mLeftVectorLog->logDataLine(time, leftValues);
+	mRightVectorLog->logDataLine(time, rightValues);
 }
 
 template <typename VarType>
@@ -0,0 +1,187 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim/MNASolverEnsemble.h>
+
+using namespace DPsim;
+using namespace CPS;
+
+namespace DPsim {
+
+template <typename VarType>
+MnaSolverEnsemble<VarType>::MnaSolverEnsemble(String name,
+	CPS::Domain domain, CPS::Logger::Level logLevel) :
+	MnaSolver<VarType>(name, domain, logLevel) { }
+
+template <typename VarType>
+void MnaSolverEnsemble<VarType>::initialize() {
+	// All switch configurations have to be precomputed because they are
+	// shared by all scenarios, which are solved together as real system
+	if (this->mSwitchCacheSize > 0) {
+		this->mSLog->warn("Switch cache is not supported with scenarios, precompute all switch configurations");
+		this->mSwitchCacheSize = 0;
+	}
+	if (this->mSwitchLowRankUpdate) {
+		this->mSLog->warn("Low-rank switch updates are not supported with scenarios, precompute all switch configurations");
+		this->mSwitchLowRankUpdate = false;
+	}
+	if (this->mFrequencyParallel) {
+		this->mSLog->warn("Frequency parallelization is not supported with scenarios and is disabled");
+		this->mFrequencyParallel = false;
+	}
+	if (this->mComplexSparseSolve) {
+		this->mSLog->warn("Complex sparse solve is not supported with scenarios, solve split system instead");
+		this->mComplexSparseSolve = false;
+	}
+	if (this->mLevelScheduledSolve) {
+		this->mSLog->warn("Level-scheduled solve is not supported with scenarios and is disabled");
+		this->mLevelScheduledSolve = false;
+	}
+
+	mEnsembleInitialized = false;
+	MnaSolver<VarType>::initialize();
+
+	mScenarios = { this };
+	mScenarioSolvers.clear();
+	for (UInt idx = 0; idx < mScenarioSystems.size(); idx++) {
+		auto scenario = std::make_shared<MnaSolver<VarType>>(
+			this->mName + "_Scenario" + std::to_string(idx + 1), this->mDomain, this->mLogLevel);
+		scenario->setTimeStep(this->mTimeStep);
+		scenario->doSteadyStateInit(this->mSteadyStateInit);
+		scenario->setSteadStIniTimeLimit(this->mSteadStIniTimeLimit);
+		scenario->setSteadStIniAccLimit(this->mSteadStIniAccLimit);
+		scenario->setNodeOrdering(this->mNodeOrdering);
+		scenario->doVectorLogging(this->mVectorLogDownsampling > 0, this->mVectorLogDownsampling);
+		scenario->setVectorLogNodes(this->mVectorLogNodeNames);
+		scenario->setVectorLogNodes(this->mVectorLogNodeIndices);
+		scenario->setSystem(mScenarioSystems[idx]);
+		// The scenario is solved with the factorizations of this solver
+		scenario->mFactorizeSystem = false;
+		scenario->initialize();
+
+		checkScenario(*scenario, idx + 1);
+
+		mScenarioSolvers.push_back(scenario);
+		mScenarios.push_back(scenario.get());
+	}
+
+	mRightSideVectors = Matrix::Zero(this->mRightSideVector.rows(), mScenarios.size());
+	mLeftSideVectors = Matrix::Zero(this->mLeftSideVector.rows(), mScenarios.size());
+	mEnsembleInitialized = true;
+
+	this->mSLog->info("Solving {:d} scenarios with shared factorization", mScenarios.size());
+}
+
+template <typename VarType>
+void MnaSolverEnsemble<VarType>::checkScenario(MnaSolver<VarType>& scenario, UInt scenarioIdx) {
+	String scenarioName = "Scenario " + std::to_string(scenarioIdx);
+
+	if (scenario.mNumMatrixNodeIndices != this->mNumMatrixNodeIndices
+		|| scenario.mSwitches.size() != this->mSwitches.size())
+		throw SystemError(scenarioName + ": topology differs from first scenario.");
+
+	// Switch configurations are identified by the position of each switch
+	for (UInt i = 0; i < this->mSwitches.size(); i++) {
+		auto switchObj = std::dynamic_pointer_cast<IdentifiedObject>(this->mSwitches[i]);
+		auto scenarioSwitchObj = std::dynamic_pointer_cast<IdentifiedObject>(scenario.mSwitches[i]);
+		if (switchObj->name() != scenarioSwitchObj->name())
+			throw SystemError(scenarioName + ": switch " + scenarioSwitchObj->name()
+				+ " is at the position of switch " + switchObj->name() + " in first scenario.");
+	}
+
+	// The shared factorizations are only valid if all system matrices are equal
+	MAT_TYPE systemMatrix;
+	for (auto& sys : this->mSwitchedMatrices) {
+		scenario.stampSystemMatrix(systemMatrix, sys.first);
+		if (!systemMatrix.isApprox(sys.second))
+			throw SystemError(scenarioName + ": system matrix for switch configuration "
+				+ sys.first.to_string() + " differs from first scenario.");
+	}
+}
+
+template <typename VarType>
+void MnaSolverEnsemble<VarType>::solve(Real time, Int timeStepCount) {
+	// Steady-state initialization of the first scenario runs before
+	// the other scenarios exist
+	if (!mEnsembleInitialized) {
+		MnaSolver<VarType>::solve(time, timeStepCount);
+		return;
+	}
+
+	// Add together the right side vector of each scenario
+	for (UInt idx = 0; idx < mScenarios.size(); idx++) {
+		auto scenario = mScenarios[idx];
+		scenario->mRightSideVector.setZero();
+		scenario->addRightVectorStamps();
+		mRightSideVectors.col(idx) = scenario->mRightSideVector;
+	}
+
+	// Scenarios with the same switch configuration share one solve
+	std::unordered_map< std::bitset<SWITCH_NUM>, std::vector<UInt> > groups;
+	for (UInt idx = 0; idx < mScenarios.size(); idx++)
+		groups[mScenarios[idx]->mCurrentSwitchStatus].push_back(idx);
+
+	if (groups.size() == 1) {
+		mLeftSideVectors = this->mLuFactorizations[groups.begin()->first].solve(mRightSideVectors);
+	}
+	else {
+		for (auto& group : groups) {
+			Matrix rightSideVectors(mRightSideVectors.rows(), group.second.size());
+			for (UInt col = 0; col < group.second.size(); col++)
+				rightSideVectors.col(col) = mRightSideVectors.col(group.second[col]);
+
+			Matrix leftSideVectors = this->mLuFactorizations[group.first].solve(rightSideVectors);
+			for (UInt col = 0; col < group.second.size(); col++)
+				mLeftSideVectors.col(group.second[col]) = leftSideVectors.col(col);
+		}
+	}
+
+	for (UInt idx = 0; idx < mScenarios.size(); idx++) {
+		auto scenario = mScenarios[idx];
+		scenario->mLeftSideVector = mLeftSideVectors.col(idx);
+
+		for (UInt nodeIdx = 0; nodeIdx < scenario->mNumNetNodes; nodeIdx++)
+			scenario->mNodes[nodeIdx]->mnaUpdateVoltage(scenario->mLeftSideVector);
+
+		if (!scenario->mIsInInitialization)
+			scenario->updateSwitchStatus();
+	}
+}
+
+template <typename VarType>
+Task::List MnaSolverEnsemble<VarType>::getTasks() {
+	Task::List l;
+
+	for (auto scenario : mScenarios) {
+		for (auto comp : scenario->mMNAComponents) {
+			for (auto task : comp->mnaTasks())
+				l.push_back(task);
+		}
+		for (auto comp : scenario->mSwitches) {
+			for (auto task : comp->mnaTasks())
+				l.push_back(task);
+		}
+		for (auto node : scenario->mNodes) {
+			for (auto task : node->mnaTasks())
+				l.push_back(task);
+		}
+		// TODO signal components should be moved out of MNA solver
+		for (auto comp : scenario->mSimSignalComps) {
+			for (auto task : comp->getTasksAtRate())
+				l.push_back(task);
+		}
+		l.push_back(std::make_shared<typename MnaSolver<VarType>::LogTask>(*scenario));
+	}
+	l.push_back(std::make_shared<MnaSolverEnsemble<VarType>::SolveTask>(*this));
+	return l;
+}
+
+}
+
+template class DPsim::MnaSolverEnsemble<Real>;
+template class DPsim::MnaSolverEnsemble<Complex>;
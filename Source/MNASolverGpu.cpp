@@ -147,7 +147,7 @@ Task::List MnaSolverGpu<VarType>::getTasks() {
 	}
 	// TODO signal components should be moved out of MNA solver
 	for (auto comp : this->mSimSignalComps) {
-		for (auto task : comp->getTasks()) {
+		for (auto task : comp->getTasksAtRate()) {
 			l.push_back(task);
 		}
 	}
@@ -163,8 +163,7 @@ void MnaSolverGpu<VarType>::solve(Real time, Int timeStepCount) {
 
     // Add together the right side vector (computed by the components'
 	// pre-step tasks)
-	for (const auto &stamp : this->mRightVectorStamps)
-		this->mRightSideVector += *stamp;
+	this->addRightVectorStamps();
 
     //Copy right vector to device
     CUDA_ERROR_HANDLER(cudaMemcpy(mDeviceCopy.vector, &this->mRightSideVector(0), mDeviceCopy.size * sizeof(Real), cudaMemcpyHostToDevice))
@@ -19,6 +19,25 @@ MnaSolverSysRecomp<VarType>::MnaSolverSysRecomp(String name,
 	CPS::Domain domain, CPS::Logger::Level logLevel) :
     MnaSolver<VarType>(name, domain, logLevel) { }
 
+template <typename VarType>
+void MnaSolverSysRecomp<VarType>::initialize() {
+	// The system matrix is recomputed in place, so there is only one
+	// factorization that is updated on changes
+	if (this->mSwitchCacheSize > 0) {
+		this->mSLog->warn("Switch cache is not supported with system recomputation and is ignored");
+		this->mSwitchCacheSize = 0;
+	}
+	if (this->mComplexSparseSolve) {
+		this->mSLog->warn("Complex sparse solve is not supported with system recomputation and is ignored");
+		this->mComplexSparseSolve = false;
+	}
+	if (this->mSwitchLowRankUpdate) {
+		this->mSLog->warn("Switch low-rank update is not supported with system recomputation and is ignored");
+		this->mSwitchLowRankUpdate = false;
+	}
+	MnaSolver<VarType>::initialize();
+}
+
 template <typename VarType>
 void MnaSolverSysRecomp<VarType>::initializeSystem() {
 	this->mSLog->info("-- Initialize MNA system matrices and source vector");
@@ -29,6 +48,10 @@ void MnaSolverSysRecomp<VarType>::initializeSystem() {
 		this->mVariableComps.size(),
 		this->mMNAComponents.size());
 
+#ifdef WITH_SPARSE
+	this->reserveSystemMatrix(this->mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)]);
+#endif
+
 	this->mSLog->info("Stamping MNA fixed components");
 	for (auto comp : this->mMNAComponents) {
 		// Do not stamp variable elements yet
@@ -48,15 +71,25 @@ void MnaSolverSysRecomp<VarType>::initializeSystem() {
 		varElem->mnaApplySystemMatrixStamp(this->mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)]);
 	}
 #ifdef WITH_SPARSE
-	this->mLuFactorizations[std::bitset<SWITCH_NUM>(0)].analyzePattern(this->mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)]);
+	this->mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)].makeCompressed();
+
+	// Store explicit zeros for the entries of the variable elements in the base
+	// matrix. Then, restamping does not change the sparsity pattern and the
+	// symbolic analysis can be reused.
+	SparseMatrix variableStamps(this->mBaseSystemMatrix.rows(), this->mBaseSystemMatrix.cols());
+	for (auto varElem : this->mMNAIntfVariableComps)
+		varElem->mnaApplySystemMatrixStamp(variableStamps);
+	SparseMatrix basePattern = this->mBaseSystemMatrix + 0.0 * variableStamps;
+	this->mBaseSystemMatrix = basePattern;
+
+	analyzeSystemMatrixPattern();
 	this->mLuFactorizations[std::bitset<SWITCH_NUM>(0)].factorize(this->mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)]);
 #else
 	this->mLuFactorizations[std::bitset<SWITCH_NUM>(0)] = Eigen::PartialPivLU<Matrix>(this->mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)]);
 #endif
 	// Initialize source vector for debugging
-	for (auto comp : this->mMNAComponents) {
-		comp->mnaApplyRightSideVectorStamp(this->mRightSideVector);
-	}
+	for (auto comp : this->mMNAComponents)
+		this->stampRightSideVector(comp);
 }
 
 template <typename VarType>
@@ -86,7 +119,12 @@ void MnaSolverSysRecomp<VarType>::updateSystemMatrix(Real time) {
 			idObj->type(), idObj->name());
 	}
 #ifdef WITH_SPARSE
-	this->mLuFactorizations[std::bitset<SWITCH_NUM>(0)].analyzePattern(this->mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)]);
+	this->mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)].makeCompressed();
+	// Only the numerical factorization is required if the pattern did not change
+	if (!hasAnalyzedPattern()) {
+		this->mSLog->info("Sparsity pattern changed -> Redo symbolic analysis");
+		analyzeSystemMatrixPattern();
+	}
 	this->mLuFactorizations[std::bitset<SWITCH_NUM>(0)].factorize(this->mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)]);
 #else
 	this->mLuFactorizations[std::bitset<SWITCH_NUM>(0)] = Eigen::PartialPivLU<Matrix>(this->mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)]);
@@ -94,6 +132,26 @@ void MnaSolverSysRecomp<VarType>::updateSystemMatrix(Real time) {
 	mUpdateSysMatrix = false;
 }
 
+#ifdef WITH_SPARSE
+template <typename VarType>
+void MnaSolverSysRecomp<VarType>::analyzeSystemMatrixPattern() {
+	auto& sys = this->mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)];
+	this->analyzeSystemMatrix(this->mLuFactorizations[std::bitset<SWITCH_NUM>(0)], sys);
+	mAnalyzedOuterIndices.assign(sys.outerIndexPtr(), sys.outerIndexPtr() + sys.outerSize() + 1);
+	mAnalyzedInnerIndices.assign(sys.innerIndexPtr(), sys.innerIndexPtr() + sys.nonZeros());
+}
+
+template <typename VarType>
+Bool MnaSolverSysRecomp<VarType>::hasAnalyzedPattern() {
+	auto& sys = this->mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)];
+	if (mAnalyzedOuterIndices.size() != (std::size_t) sys.outerSize() + 1
+		|| mAnalyzedInnerIndices.size() != (std::size_t) sys.nonZeros())
+		return false;
+	return std::equal(mAnalyzedOuterIndices.begin(), mAnalyzedOuterIndices.end(), sys.outerIndexPtr())
+		&& std::equal(mAnalyzedInnerIndices.begin(), mAnalyzedInnerIndices.end(), sys.innerIndexPtr());
+}
+#endif
+
 template <typename VarType>
 void MnaSolverSysRecomp<VarType>::solve(Real time, Int timeStepCount) {
 	// Reset source vector
@@ -102,8 +160,7 @@ void MnaSolverSysRecomp<VarType>::solve(Real time, Int timeStepCount) {
 
 	// Add together the right side vector (computed by the components'
 	// pre-step tasks)
-	for (auto stamp : this->mRightVectorStamps)
-		this->mRightSideVector += *stamp;
+	this->addRightVectorStamps();
 
 	if (this->mSwitchedMatrices.size() > 0)
 		this->mLeftSideVector = this->mLuFactorizations[this->mCurrentSwitchStatus].solve(this->mRightSideVector);
@@ -139,7 +196,7 @@ Task::List MnaSolverSysRecomp<VarType>::getTasks() {
 	}
 	// TODO signal components should be moved out of MNA solver
 	for (auto comp : this->mSimSignalComps) {
-		for (auto task : comp->getTasks())
+		for (auto task : comp->getTasksAtRate())
 			l.push_back(task);
 	}
 
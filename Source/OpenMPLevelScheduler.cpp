@@ -9,6 +9,7 @@
 #include <dpsim/OpenMPLevelScheduler.h>
 #include <omp.h>
 
+#include <exception>
 #include <iostream>
 
 using namespace CPS;
@@ -22,39 +23,59 @@ OpenMPLevelScheduler::OpenMPLevelScheduler(Int threads, String outMeasurementFil
 }
 
 void OpenMPLevelScheduler::createSchedule(const Task::List& tasks, const Edges& inEdges, const Edges& outEdges) {
-	Task::List ordered;
-
-	Scheduler::topologicalSort(tasks, inEdges, outEdges, ordered);
-	Scheduler::levelSchedule(ordered, inEdges, outEdges, mLevels);
+	Scheduler::compileGraph(tasks, inEdges, outEdges, mGraph);
 
 	if (!mOutMeasurementFile.empty())
 		Scheduler::initMeasurements(tasks);
+
+	// The OpenMP runtime reuses the threads of a team for the following
+	// parallel regions, so that the threads only have to be configured once.
+	// The master thread of the team is the thread calling step.
+	if (!mThreadCpus.empty() || mThreadPriority > 0) {
+		std::exception_ptr error;
+		#pragma omp parallel num_threads(mNumThreads)
+		{
+			try {
+				configureThread(omp_get_thread_num());
+			}
+			catch (...) {
+				#pragma omp critical
+				error = std::current_exception();
+			}
+		}
+		if (error)
+			std::rethrow_exception(error);
+	}
 }
 
 void OpenMPLevelScheduler::step(Real time, Int timeStepCount) {
-	size_t i = 0, level = 0;
+	Int i = 0, level = 0;
 	std::chrono::steady_clock::time_point start, end;
 
 	if (!mOutMeasurementFile.empty()) {
 		#pragma omp parallel shared(time,timeStepCount) private(level, i, start, end) num_threads(mNumThreads)
-		for (level = 0; level < mLevels.size(); level++) {
+		for (level = 0; level < mGraph.numLevels(); level++) {
 			{
+				const Int* levelTasks = mGraph.levelBegin(level);
+				Int levelSize = static_cast<Int>(mGraph.levelEnd(level) - levelTasks);
 				#pragma omp for schedule(static)
-				for (i = 0; i < mLevels[level].size(); i++) {
+				for (i = 0; i < levelSize; i++) {
 					start = std::chrono::steady_clock::now();
-					mLevels[level][i]->execute(time, timeStepCount);
+					mGraph.task(levelTasks[i])->execute(time, timeStepCount);
 					end = std::chrono::steady_clock::now();
-					updateMeasurement(mLevels[level][i].get(), end-start);
+					updateMeasurement(mGraph.task(levelTasks[i]), end-start);
 				}
 			}
 		}
 	} else {
 		#pragma omp parallel shared(time,timeStepCount) private(level, i) num_threads(mNumThreads)
-		for (level = 0; level < mLevels.size(); level++) {
+		for (level = 0; level < mGraph.numLevels(); level++) {
 			{
+				const Int* levelTasks = mGraph.levelBegin(level);
+				Int levelSize = static_cast<Int>(mGraph.levelEnd(level) - levelTasks);
 				#pragma omp for schedule(static)
-				for (i = 0; i < mLevels[level].size(); i++) {
-					mLevels[level][i]->execute(time, timeStepCount);
+				for (i = 0; i < levelSize; i++) {
+					mGraph.task(levelTasks[i])->execute(time, timeStepCount);
 				}
 			}
 		}
@@ -21,6 +21,7 @@
 #include <cps/Logger.h>
 #include <dpsim/PthreadPoolScheduler.h>
 
+#include <algorithm>
 #include <iostream>
 
 #include <villas/memory.h>
@@ -43,16 +44,19 @@ PthreadPoolScheduler::~PthreadPoolScheduler() {
 }
 
 void PthreadPoolScheduler::createSchedule(const Task::List& tasks, const Edges& inEdges, const Edges& outEdges) {
-	// TODO: we're not actually creating the schedule here, but just copying
+	// TODO: we're not actually creating the schedule here, but just compiling
 	// the dependency graph so we can do the schedule dynamically in every step
-	mTasks = tasks;
-	mInEdges = inEdges;
-	mOutEdges = outEdges;
+	Scheduler::compileGraph(tasks, inEdges, outEdges, mGraph);
+	mTasks = mGraph.tasks();
+
+	if (!mThreadCpus.empty() || mThreadPriority > 0)
+		throw SystemError("PthreadPoolScheduler does not support thread affinity and priority");
+	mPendingInDegrees.resize(mTasks.size());
 
 	// TODO Wastes memory, but guarantees that the writes always succeed.
 	// Figure out a smarter way to do this.
-	(void)!queue_signalled_init(&mOutQueue, tasks.size(), &memory_heap, QueueSignalledMode::POLLING);
-	(void)!queue_signalled_init(&mDoneQueue, tasks.size(), &memory_heap, QueueSignalledMode::POLLING);
+	(void)!queue_signalled_init(&mOutQueue, mTasks.size(), &memory_heap, QueueSignalledMode::POLLING);
+	(void)!queue_signalled_init(&mDoneQueue, mTasks.size(), &memory_heap, QueueSignalledMode::POLLING);
 
 	for (size_t i = 0; i < mThreads.size(); i++) {
 		if (pthread_create(&mThreads[i], NULL, poolThreadFunction, this))
@@ -66,13 +70,13 @@ void PthreadPoolScheduler::step(Real time, Int timeStepCount) {
 	mTime = time;
 	mTimeStepCount = timeStepCount;
 
-	// copy incoming edges since we remove them during execution to mark a dependency as "done"
-	Edges inEdgesCpy = mInEdges;
+	// reset the dependency counters since we decrement them during execution to mark a dependency as "done"
+	std::copy(mGraph.inDegrees().begin(), mGraph.inDegrees().end(), mPendingInDegrees.begin());
 
 	// Basically topological sort, but instead of marking tasks as ready, send them to the worker pool,
 	// and check if another task can be run everytime a task finishes.
 	for (size_t i = 0; i < mTasks.size(); i++) {
-		if (inEdgesCpy[mTasks[i]].empty()) {
+		if (mPendingInDegrees[i] == 0) {
 			// TODO since mTasks already contains smart pointers, the additional
 			// indirection is kind of unnecessary and defeats the smart pointers'
 			// purpose (although it should at least be safe)
@@ -83,28 +87,20 @@ void PthreadPoolScheduler::step(Real time, Int timeStepCount) {
 	}
 
 	size_t done = 0;
-	Task::Ptr t;
 	void *p;
 	while (done != mTasks.size()) {
 		if (queue_signalled_pull(&mDoneQueue, &p) != 1)
 			throw SchedulingException();
-		t = *static_cast<Task::Ptr*>(p);
-		//std::cout << "scheduler: " << t->toString() << " done" << std::endl;
+		Int t = static_cast<Int>(static_cast<Task::Ptr*>(p) - mTasks.data());
+		//std::cout << "scheduler: " << mTasks[t]->toString() << " done" << std::endl;
 		done++;
-		for (size_t i = 0; i < mOutEdges[t].size(); i++) {
-			Task::Ptr after = mOutEdges[t][i];
-			for (auto edgeIt = inEdgesCpy[after].begin(); edgeIt != inEdgesCpy[after].end(); ++edgeIt) {
-				if (*edgeIt == t) {
-					inEdgesCpy[after].erase(edgeIt);
-					break;
-				}
-			}
-			if (inEdgesCpy[after].empty()) {
+		for (auto after = mGraph.successorsBegin(t); after != mGraph.successorsEnd(t); ++after) {
+			if (--mPendingInDegrees[*after] == 0) {
 				// TODO: somewhat of a hack (see above), but should be safe
-				// since mOutEdges is not modified during a step
-				if (queue_signalled_push(&mOutQueue, &mOutEdges[t][i]) != 1)
+				// since mTasks is not modified during a step
+				if (queue_signalled_push(&mOutQueue, &mTasks[*after]) != 1)
 					throw SchedulingException();
-				//std::cout << "scheduler: pushed " << after->toString() << std::endl;
+				//std::cout << "scheduler: pushed " << mTasks[*after]->toString() << std::endl;
 			}
 		}
 	}
@@ -113,7 +109,7 @@ void PthreadPoolScheduler::step(Real time, Int timeStepCount) {
 
 void* PthreadPoolScheduler::poolThreadFunction(void* data) {
 	PthreadPoolScheduler* sched = static_cast<PthreadPoolScheduler*>(data);
-	Task::Ptr t;
+	Task* t;
 	void* p;
 
 	while (1) {
@@ -122,7 +118,7 @@ void* PthreadPoolScheduler::poolThreadFunction(void* data) {
 		if (!p)
 			break;
 
-		t = *static_cast<Task::Ptr*>(p);
+		t = static_cast<Task::Ptr*>(p)->get();
 		//std::cout << "worker: pulled " << t->toString() << std::endl;
 		t->execute(sched->mTime, sched->mTimeStepCount);
 		if (queue_signalled_push(&sched->mDoneQueue, p) != 1)
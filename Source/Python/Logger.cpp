@@ -107,14 +107,19 @@ PyObject* Python::Logger::logAttribute(Logger* self, PyObject* args, PyObject *k
 
 int Python::Logger::init(Python::Logger *self, PyObject *args, PyObject *kwds)
 {
-	static const char *kwlist[] = {"filename", "down_sampling", nullptr};
+	static const char *kwlist[] = {"filename", "down_sampling", "binary", "async_buffer_size", nullptr};
 	int downsampling = 1;
+	int binary = 0;
+	int asyncBufferSize = 0;
 
-	if (!PyArg_ParseTupleAndKeywords(args, kwds, "s|i", (char **) kwlist, &self->filename, &downsampling)) {
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "s|ipi", (char **) kwlist, &self->filename, &downsampling, &binary, &asyncBufferSize)) {
 		return -1;
 	}
 
-	self->logger = DPsim::DataLogger::make(self->filename, true, downsampling);
+	self->logger = DPsim::DataLogger::make(self->filename, true, downsampling,
+		binary ? DPsim::DataLogger::Format::Binary : DPsim::DataLogger::Format::CSV);
+	if (asyncBufferSize > 0)
+		self->logger->setAsync(asyncBufferSize);
 
 	return 0;
 }
@@ -130,7 +135,11 @@ PyMethodDef Python::Logger::methods[] = {
 };
 
 const char* Python::Logger::doc =
-"__init__(filename)\n";
+"__init__(filename, down_sampling=1, binary=False, async_buffer_size=0)\n"
+"If binary is set, the values are written in the binary columnar format, "
+"which can be read with ``dpsim.BinaryLog.BinaryLog`` or "
+"``dpsim.BinaryLog.read_binary_log``. If async_buffer_size is set, "
+"the values are buffered and written by a separate thread.\n";
 PyTypeObject Python::Logger::type = {
 	PyVarObject_HEAD_INIT(nullptr, 0)
 	"dpsim.Logger",                          /* tp_name */
@@ -28,6 +28,8 @@
 #include <dpsim/SequentialScheduler.h>
 #include <dpsim/ThreadLevelScheduler.h>
 #include <dpsim/ThreadListScheduler.h>
+#include <dpsim/ThreadHEFTScheduler.h>
+#include <dpsim/ThreadPoolScheduler.h>
 #include <cps/DP/DP_Ph1_Switch.h>
 
 #ifdef WITH_OPENMP
@@ -123,6 +125,7 @@ void Python::Simulation::threadFunction(Python::Simulation *self)
 	}
 
 	self->sim->scheduler()->stop();
+	self->sim->stopPipeline();
 
 #ifdef WITH_SHMEM
 	for (auto ifm : self->sim->interfaces())
@@ -678,6 +681,14 @@ PyObject* Python::Simulation::setScheduler(Simulation *self, PyObject *args, PyO
 		if (threads <= 0)
 			threads = 1;
 		self->sim->setScheduler(std::make_shared<ThreadListScheduler>(threads, outMeasurementFile, inMeasurementFile, useConditionVariable));
+	} else if (!strcmp(schedName, "thread_heft")) {
+		if (threads <= 0)
+			threads = 1;
+		self->sim->setScheduler(std::make_shared<ThreadHEFTScheduler>(threads, outMeasurementFile, inMeasurementFile, useConditionVariable));
+	} else if (!strcmp(schedName, "thread_pool")) {
+		if (threads <= 0)
+			threads = 1;
+		self->sim->setScheduler(std::make_shared<ThreadPoolScheduler>(threads, outMeasurementFile));
 	} else {
 		PyErr_SetString(PyExc_ValueError, "invalid scheduler");
 		return nullptr;
@@ -686,6 +697,69 @@ PyObject* Python::Simulation::setScheduler(Simulation *self, PyObject *args, PyO
 	Py_RETURN_NONE;
 }
 
+const char *Python::Simulation::docDoVectorLogging =
+"do_vector_logging(value=True, downsampling=1)\n"
+"Enable logging of the solution vectors of the solvers to <name>_LeftVector.csv "
+"and <name>_RightVector.csv. Only every downsampling-th step is logged. "
+"Must be called before the simulation is started.\n";
+PyObject* Python::Simulation::doVectorLogging(Simulation *self, PyObject *args, PyObject *kwargs)
+{
+	bool value = true;
+	unsigned int downsampling = 1;
+
+	const char *kwlist[] = {"value", "downsampling", nullptr};
+
+	if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|bI", (char **) kwlist, &value, &downsampling))
+		return nullptr;
+
+	self->sim->doVectorLogging(value, downsampling);
+
+	Py_RETURN_NONE;
+}
+
+const char *Python::Simulation::docSetVectorLogNodes =
+"set_vector_log_nodes(nodes)\n"
+"Restrict the vector logs to the given nodes, either a list of node names "
+"or a list of node indices. Must be called before the simulation is started.\n";
+PyObject* Python::Simulation::setVectorLogNodes(Simulation *self, PyObject *args)
+{
+	PyObject *pyNodes;
+
+	if (!PyArg_ParseTuple(args, "O", &pyNodes))
+		return nullptr;
+
+	if (!PyList_Check(pyNodes)) {
+		PyErr_SetString(PyExc_TypeError, "First argument must be a list of node names or indices");
+		return nullptr;
+	}
+
+	std::vector<String> names;
+	std::vector<UInt> indices;
+
+	for (Py_ssize_t i = 0; i < PyList_Size(pyNodes); i++) {
+		PyObject *pyNode = PyList_GetItem(pyNodes, i);
+
+		if (PyUnicode_Check(pyNode) && indices.empty()) {
+			names.push_back(PyUnicode_AsUTF8(pyNode));
+		} else if (PyLong_Check(pyNode) && names.empty()) {
+			unsigned long idx = PyLong_AsUnsignedLong(pyNode);
+			if (PyErr_Occurred())
+				return nullptr;
+			indices.push_back(static_cast<UInt>(idx));
+		} else {
+			PyErr_SetString(PyExc_TypeError, "First argument must be a list of node names or indices");
+			return nullptr;
+		}
+	}
+
+	if (indices.empty())
+		self->sim->setVectorLogNodes(names);
+	else
+		self->sim->setVectorLogNodes(indices);
+
+	Py_RETURN_NONE;
+}
+
 #ifdef WITH_GRAPHVIZ
 const char *Python::Simulation::docReprSVG =
 "_repr_svg_()\n"
@@ -746,11 +820,7 @@ PyObject* Python::Simulation::avgStepTime(Simulation *self, void *ctx)
 {
 	std::unique_lock<std::mutex> lk(*self->mut);
 
-	Real tot = 0;
-	for (auto meas : self->sim->stepTimes()) {
-		tot += meas;
-	}
-	Real avg = tot / self->sim->stepTimes().size();
+	Real avg = std::chrono::duration<Real>(self->sim->stepTimeStatistics().mean()).count();
 
 	return Py_BuildValue("f", avg);
 }
@@ -791,6 +861,8 @@ PyMethodDef Python::Simulation::methods[] = {
 	{"add_eventfd",   (PyCFunction) Python::Simulation::addEventFD, METH_VARARGS, (char *) Python::Simulation::docAddEventFD},
 	{"remove_eventfd",(PyCFunction) Python::Simulation::removeEventFD, METH_VARARGS, (char *) Python::Simulation::docRemoveEventFD},
 	{"set_scheduler", (PyCFunction) Python::Simulation::setScheduler, METH_VARARGS | METH_KEYWORDS, (char*) Python::Simulation::docSetScheduler},
+	{"do_vector_logging", (PyCFunction) Python::Simulation::doVectorLogging, METH_VARARGS | METH_KEYWORDS, (char*) Python::Simulation::docDoVectorLogging},
+	{"set_vector_log_nodes", (PyCFunction) Python::Simulation::setVectorLogNodes, METH_VARARGS, (char*) Python::Simulation::docSetVectorLogNodes},
 #ifdef WITH_GRAPHVIZ
 	{"_repr_svg_",    (PyCFunction) Python::Simulation::reprSVG, METH_NOARGS, (char*) Python::Simulation::docReprSVG},
 #endif
@@ -0,0 +1,112 @@
+import mmap
+import struct
+
+import numpy
+
+MAGIC = b'DPSIMLOG'
+VERSION = 1
+
+COLUMN_REAL = 0
+COLUMN_INT = 1
+COLUMN_OTHER = 2
+
+class BinaryLog(object):
+    """ Reader for the binary columnar format of the DPsim DataLogger.
+
+        The file is mapped into memory and the columns are returned as numpy
+        arrays without parsing. See Include/dpsim/BinaryLog.h for the layout.
+    """
+
+    def __init__(self, filename):
+        self._file = open(filename, 'rb')
+        try:
+            self._map = mmap.mmap(self._file.fileno(), 0, access=mmap.ACCESS_READ)
+        except ValueError:
+            self._file.close()
+            raise ValueError('Empty binary log: ' + filename)
+
+        if self._map[0:8] != MAGIC:
+            self.close()
+            raise ValueError('Not a binary log: ' + filename)
+
+        version, ncols, _, header_size = struct.unpack_from('=IIII', self._map, 8)
+        if version != VERSION:
+            self.close()
+            raise ValueError('Unsupported binary log version %d' % version)
+
+        self.names = []
+        self.types = []
+        offset = 24
+        for _ in range(ncols):
+            coltype, _, length = struct.unpack_from('=BBH', self._map, offset)
+            offset += 4
+            self.names.append(self._map[offset:offset + length].decode())
+            self.types.append(coltype)
+            offset += length
+
+        # Index of the complete blocks as (offset of the values, rows)
+        self._blocks = []
+        offset = header_size
+        while offset + 8 <= len(self._map):
+            rows, = struct.unpack_from('=Q', self._map, offset)
+            offset += 8
+            size = rows * ncols * 8
+            if offset + size > len(self._map):
+                break
+            self._blocks.append((offset, rows))
+            offset += size
+
+        self.rows = sum(rows for _, rows in self._blocks)
+
+    def close(self):
+        try:
+            self._map.close()
+        except BufferError:
+            # Arrays returned by column still refer to the mapping,
+            # which is released together with them
+            pass
+        self._file.close()
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *args):
+        self.close()
+
+    def column(self, name):
+        """ Values of the column with the given name or index as numpy array """
+        idx = self.names.index(name) if isinstance(name, str) else name
+        ncols = len(self.names)
+        parts = [ numpy.frombuffer(self._map, dtype=numpy.float64, count=rows * ncols, offset=offset)[idx * rows:(idx + 1) * rows]
+                  for offset, rows in self._blocks ]
+        if len(parts) == 1:
+            return parts[0]
+        if not parts:
+            return numpy.empty(0)
+        return numpy.concatenate(parts)
+
+    def columns(self):
+        """ Dictionary of all columns including the time """
+        return { name: self.column(idx) for idx, name in enumerate(self.names) }
+
+    def to_csv(self, filename):
+        """ Writes the values in the CSV format of the DataLogger """
+        cols = [ self.column(idx) for idx in range(len(self.names)) ]
+        with open(filename, 'w') as f:
+            f.write('%14s' % 'time')
+            for name in self.names[1:]:
+                f.write(', %13s' % name)
+            f.write('\n')
+            for row in range(self.rows):
+                f.write('%14e' % cols[0][row])
+                for idx in range(1, len(cols)):
+                    if self.types[idx] == COLUMN_INT:
+                        f.write(', %13d' % int(cols[idx][row]))
+                    else:
+                        f.write(', %13f' % cols[idx][row])
+                f.write('\n')
+
+def read_binary_log(filename):
+    """ Reads all columns of a binary log into a dictionary of numpy arrays """
+    with BinaryLog(filename) as log:
+        return { name: numpy.array(values) for name, values in log.columns().items() }
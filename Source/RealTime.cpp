@@ -0,0 +1,129 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <cerrno>
+#include <cstdlib>
+#include <sstream>
+#include <stdexcept>
+
+#include <dpsim/RealTime.h>
+
+#ifdef WITH_RT
+  #include <alloca.h>
+  #include <malloc.h>
+  #include <pthread.h>
+  #include <sched.h>
+  #include <unistd.h>
+  #include <sys/mman.h>
+#endif
+
+using namespace CPS;
+using namespace DPsim;
+
+std::vector<Int> RealTime::parseCpuList(const String& list) {
+	std::vector<Int> cpus;
+	std::istringstream stream(list);
+	String range;
+
+	while (std::getline(stream, range, ',')) {
+		if (range.empty())
+			continue;
+
+		auto sep = range.find('-');
+		Int first = std::stoi(range.substr(0, sep));
+		Int last = sep == String::npos ? first : std::stoi(range.substr(sep + 1));
+		if (first < 0 || last < first)
+			throw std::invalid_argument("Invalid CPU list: " + list);
+
+		for (Int cpu = first; cpu <= last; cpu++)
+			cpus.push_back(cpu);
+	}
+
+	return cpus;
+}
+
+#ifdef WITH_RT
+
+void RealTime::setThreadAffinity(const std::vector<Int>& cpus, std::thread* thread) {
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	for (auto cpu : cpus) {
+		if (cpu < 0 || cpu >= CPU_SETSIZE)
+			throw SystemError("Invalid CPU " + std::to_string(cpu), EINVAL);
+		CPU_SET(cpu, &set);
+	}
+
+	pthread_t handle = thread ? thread->native_handle() : pthread_self();
+	int ret = pthread_setaffinity_np(handle, sizeof(set), &set);
+	if (ret)
+		throw SystemError("Failed to set CPU affinity", ret);
+}
+
+void RealTime::setThreadPriority(Int priority, std::thread* thread) {
+	struct sched_param param;
+	param.sched_priority = priority;
+
+	pthread_t handle = thread ? thread->native_handle() : pthread_self();
+	int ret = pthread_setschedparam(handle, SCHED_FIFO, &param);
+	if (ret == EPERM)
+		throw SystemError("Failed to set SCHED_FIFO priority " + std::to_string(priority)
+			+ " (requires CAP_SYS_NICE or a sufficient RLIMIT_RTPRIO)", ret);
+	else if (ret)
+		throw SystemError("Failed to set SCHED_FIFO priority " + std::to_string(priority), ret);
+}
+
+void RealTime::lockMemory() {
+	if (mlockall(MCL_CURRENT | MCL_FUTURE))
+		throw SystemError("Failed to lock memory (requires CAP_IPC_LOCK or a sufficient RLIMIT_MEMLOCK)");
+
+	// Do not return freed memory to the system and serve all
+	// allocations from the heap instead of separate mappings
+	mallopt(M_TRIM_THRESHOLD, -1);
+	mallopt(M_MMAP_MAX, 0);
+}
+
+void RealTime::prefaultStack(std::size_t size) {
+	volatile char* stack = static_cast<char*>(alloca(size));
+	long pageSize = sysconf(_SC_PAGESIZE);
+
+	for (std::size_t i = 0; i < size; i += pageSize)
+		stack[i] = 0;
+}
+
+void RealTime::prefaultHeap(std::size_t size) {
+	char* heap = static_cast<char*>(std::malloc(size));
+	if (!heap)
+		throw SystemError("Failed to allocate memory for pre-faulting", ENOMEM);
+
+	volatile char* pages = heap;
+	long pageSize = sysconf(_SC_PAGESIZE);
+	for (std::size_t i = 0; i < size; i += pageSize)
+		pages[i] = 0;
+
+	std::free(heap);
+}
+
+#else
+
+void RealTime::setThreadAffinity(const std::vector<Int>& cpus, std::thread* thread) {
+	throw SystemError("CPU affinity requires real-time support", ENOSYS);
+}
+
+void RealTime::setThreadPriority(Int priority, std::thread* thread) {
+	throw SystemError("Real-time priorities require real-time support", ENOSYS);
+}
+
+void RealTime::lockMemory() {
+	throw SystemError("Memory locking requires real-time support", ENOSYS);
+}
+
+void RealTime::prefaultStack(std::size_t size) { }
+
+void RealTime::prefaultHeap(std::size_t size) { }
+
+#endif
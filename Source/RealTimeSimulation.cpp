@@ -9,6 +9,7 @@
 #include <chrono>
 #include <ctime>
 #include <dpsim/RealTimeSimulation.h>
+#include <dpsim/RealTime.h>
 #include <iomanip>
 
 using namespace CPS;
@@ -35,9 +36,31 @@ void RealTimeSimulation::run(const Timer::StartClock::duration &startIn) {
 }
 
 void RealTimeSimulation::run(const Timer::StartClock::time_point &startAt) {
+	// The simulation thread is thread 0 of the scheduler, which would
+	// otherwise be configured twice
+	if (mScheduler && !mCpus.empty() && !mScheduler->threadAffinity().empty())
+		throw SystemError("Thread affinity set for both simulation and scheduler");
+	if (mScheduler && mPriority > 0 && mScheduler->threadPriority() > 0)
+		throw SystemError("Thread priority set for both simulation and scheduler");
+
 	if (!mInitialized)
 		initialize();
 
+	if (!mCpus.empty()) {
+		RealTime::setThreadAffinity(mCpus);
+		mLog->info("Restricted simulation thread to {} CPUs", mCpus.size());
+	}
+	if (mPriority > 0) {
+		RealTime::setThreadPriority(mPriority);
+		mLog->info("Set SCHED_FIFO priority {} for simulation thread", mPriority);
+	}
+	if (mMemoryLocking) {
+		RealTime::lockMemory();
+		RealTime::prefaultStack();
+		RealTime::prefaultHeap(mPrefaultHeapSize);
+		mLog->info("Locked memory and pre-faulted {} bytes of heap", mPrefaultHeapSize);
+	}
+
 #ifdef WITH_SHMEM
 	mLog->info("Opening interfaces.");
 
@@ -68,6 +91,7 @@ void RealTimeSimulation::run(const Timer::StartClock::time_point &startAt) {
 	mLog->info("Simulation finished.");
 
 	mScheduler->stop();
+	stopPipeline();
 
 #ifdef WITH_SHMEM
 	for (auto ifm : mInterfaces)
@@ -7,37 +7,89 @@
  *********************************************************************************/
 
 #include <dpsim/Scheduler.h>
+#include <dpsim/RealTime.h>
 
+#include <algorithm>
 #include <fstream>
+#include <map>
 #include <iostream>
+#include <limits>
 #include <unordered_map>
 #include <unordered_set>
 
+#ifdef __linux__
+  #include <linux/futex.h>
+  #include <sys/syscall.h>
+  #include <unistd.h>
+#endif
+
 using namespace CPS;
 using namespace DPsim;
 
 CPS::AttributeBase::Ptr Scheduler::external;
 
-void Scheduler::initMeasurements(const Task::List& tasks) {
+void Scheduler::configureThread(Int idx, std::thread* thread) {
+	if (!mThreadCpus.empty()) {
+		Int cpu = mThreadCpus[idx % mThreadCpus.size()];
+		RealTime::setThreadAffinity({ cpu }, thread);
+		mSLog->info("Pinned thread {} to CPU {}", idx, cpu);
+	}
+	if (mThreadPriority > 0) {
+		RealTime::setThreadPriority(mThreadPriority, thread);
+		mSLog->info("Set SCHED_FIFO priority {} for thread {}", mThreadPriority, idx);
+	}
+}
+
+void Scheduler::initMeasurements(const Task::List& tasks, Bool measured) {
 	// Fill map here already since it's not protected by a mutex
 	for (auto task : tasks) {
-		mMeasurements[task.get()] = std::vector<TaskTime>();
+		mMeasurements[task.get()].reset();
+
+		auto composite = std::dynamic_pointer_cast<CompositeTask>(task);
+		if (!composite)
+			continue;
+		std::vector<TimeStatistics*> measurements;
+		if (measured) {
+			for (auto member : composite->tasks()) {
+				auto& stats = mMeasurements[member.get()];
+				stats.reset();
+				measurements.push_back(&stats);
+			}
+		}
+		composite->setMeasurements(measurements);
 	}
 }
 
 void Scheduler::updateMeasurement(Task* ptr, TaskTime time) {
-	mMeasurements[ptr].push_back(time);
+	// Only look up the entries filled by initMeasurements. Inserting would
+	// modify the map while other threads update their tasks.
+	auto it = mMeasurements.find(ptr);
+	if (it != mMeasurements.end())
+		it->second.add(std::chrono::duration_cast<TimeStatistics::Duration>(time));
 }
 
 void Scheduler::writeMeasurements(String filename) {
 	std::ofstream os(filename);
-	std::unordered_map<String, TaskTime> averages;
+	std::map<String, const TimeStatistics*> statistics;
 	for (auto& pair : mMeasurements) {
-		averages[pair.first->toString()] = getAveragedMeasurement(pair.first);
+		// Composite tasks are written as the tasks they consist of, so that
+		// the file matches task graphs with and without coarsening
+		if (dynamic_cast<CompositeTask*>(pair.first))
+			continue;
+		statistics[pair.first->toString()] = &pair.second;
 	}
-	// TODO think of nicer output format
-	for (auto pair : averages) {
-		os << pair.first << "," << pair.second.count() << std::endl;
+
+	// The mean is written first so that the files can still be read by readMeasurements
+	os << "# task,mean,count,min,max,p50,p99,p999" << std::endl;
+	for (auto pair : statistics) {
+		auto& stats = *pair.second;
+		os << pair.first << "," << stats.mean().count()
+			<< "," << stats.count()
+			<< "," << stats.min().count()
+			<< "," << stats.max().count()
+			<< "," << stats.percentile(0.5).count()
+			<< "," << stats.percentile(0.99).count()
+			<< "," << stats.percentile(0.999).count() << std::endl;
 	}
 	os.close();
 }
@@ -51,6 +103,8 @@ void Scheduler::readMeasurements(String filename, std::unordered_map<String, Tas
 	while (fs.good()) {
 		std::string line;
 		std::getline(fs, line);
+		if (!line.empty() && line[0] == '#')
+			continue;
 		int idx = static_cast<UInt>(line.find(','));
 		if (idx == -1) {
 			if (line.empty())
@@ -61,21 +115,50 @@ void Scheduler::readMeasurements(String filename, std::unordered_map<String, Tas
 	}
 }
 
-Scheduler::TaskTime Scheduler::getAveragedMeasurement(CPS::Task* task) {
-	TaskTime avg(0), tot(0);
+void Scheduler::addCompositeMeasurements(const Task::List& tasks,
+	std::unordered_map<String, TaskTime::rep>& measurements) {
+
+	for (auto task : tasks) {
+		auto composite = std::dynamic_pointer_cast<CompositeTask>(task);
+		if (!composite)
+			continue;
 
-	for (TaskTime time : mMeasurements[task]) {
-		tot += time;
+		TaskTime::rep sum = 0;
+		Bool complete = true;
+		for (auto member : composite->tasks()) {
+			auto it = measurements.find(member->toString());
+			if (it == measurements.end()) {
+				complete = false;
+				break;
+			}
+			sum += it->second;
+		}
+		if (complete)
+			measurements[composite->toString()] = sum;
 	}
+}
 
-	if (!mMeasurements[task].empty())
-		avg = tot / mMeasurements[task].size();
+Scheduler::TaskTime Scheduler::getAveragedMeasurement(CPS::Task* task) {
+	auto it = mMeasurements.find(task);
+	if (it == mMeasurements.end())
+		return TaskTime(0);
+
+	return std::chrono::duration_cast<TaskTime>(it->second.mean());
+}
 
-	return avg;
+const TimeStatistics& Scheduler::getMeasurementStatistics(Task::Ptr task) {
+	static const TimeStatistics empty;
+	auto it = mMeasurements.find(task.get());
+	return it == mMeasurements.end() ? empty : it->second;
 }
 
 
 void Scheduler::resolveDeps(Task::List& tasks, Edges& inEdges, Edges& outEdges) {
+	for (auto& task : tasks) {
+		if (task->rateDivisor() > 1)
+			task = std::make_shared<MultiRateTask>(task);
+	}
+
 	// Create graph (list of out/in edges for each node) from attribute dependencies
 	tasks.push_back(mRoot);
 	std::unordered_map<AttributeBase::Ptr, std::deque<Task::Ptr>> dependencies;
@@ -103,6 +186,165 @@ void Scheduler::resolveDeps(Task::List& tasks, Edges& inEdges, Edges& outEdges)
 	}
 }
 
+void Scheduler::coarsenTasks(Task::List& tasks, Edges& inEdges, Edges& outEdges,
+	TaskTime targetCost, String inMeasurementFile, TaskTime defaultCost) {
+
+	UInt numTasks = static_cast<UInt>(tasks.size());
+
+	// Remove tasks that are not needed so that they are not merged into
+	// composite tasks with needed ones
+	Task::List ordered;
+	topologicalSort(tasks, inEdges, outEdges, ordered);
+	std::unordered_set<Task::Ptr> needed(ordered.begin(), ordered.end());
+	needed.insert(mRoot);
+	for (auto task : tasks) {
+		if (needed.count(task))
+			continue;
+		inEdges.erase(task);
+		outEdges.erase(task);
+	}
+	tasks = ordered;
+	tasks.push_back(mRoot);
+
+	std::unordered_map<String, TaskTime::rep> measurements;
+	if (!inMeasurementFile.empty())
+		readMeasurements(inMeasurementFile, measurements);
+
+	std::unordered_map<Task::Ptr, TaskTime> costs;
+	for (auto task : tasks) {
+		auto it = measurements.find(task->toString());
+		auto avg = it != measurements.end() ? TaskTime(it->second) : getAveragedMeasurement(task);
+		costs[task] = avg > TaskTime(0) ? avg : defaultCost;
+	}
+
+	// The root task and parallel tasks have to stay separate
+	auto isFusible = [this](const Task::Ptr& task) -> Bool {
+		return task != mRoot && !std::dynamic_pointer_cast<ParallelTask>(task);
+	};
+	auto uniqueNeighbors = [](Edges& edges, const Task::Ptr& task) -> std::unordered_set<Task::Ptr> {
+		return std::unordered_set<Task::Ptr>(edges[task].begin(), edges[task].end());
+	};
+
+	// Append tasks with a single predecessor to the chain of the
+	// predecessor if it has no other successor
+
+	std::unordered_map<Task::Ptr, UInt> chainOf;
+	std::vector<Task::List> chains;
+	std::vector<TaskTime> chainCosts;
+	for (auto task : ordered) {
+		if (!isFusible(task))
+			continue;
+
+		auto before = uniqueNeighbors(inEdges, task);
+		if (before.size() == 1) {
+			auto pred = *before.begin();
+			auto it = chainOf.find(pred);
+			if (it != chainOf.end() && uniqueNeighbors(outEdges, pred).size() == 1
+				&& chainCosts[it->second] + costs[task] <= targetCost) {
+				chains[it->second].push_back(task);
+				chainCosts[it->second] += costs[task];
+				chainOf[task] = it->second;
+				continue;
+			}
+		}
+		chainOf[task] = static_cast<UInt>(chains.size());
+		chains.push_back({ task });
+		chainCosts.push_back(costs[task]);
+	}
+
+	std::unordered_set<Task::Ptr> removed;
+	Task::List added;
+	for (UInt idx = 0; idx < chains.size(); idx++) {
+		if (chains[idx].size() < 2)
+			continue;
+		auto composite = contractTasks(chains[idx], inEdges, outEdges);
+		costs[composite] = chainCosts[idx];
+		removed.insert(chains[idx].begin(), chains[idx].end());
+		added.push_back(composite);
+	}
+	tasks.erase(std::remove_if(tasks.begin(), tasks.end(),
+		[&removed](const Task::Ptr& task) { return removed.count(task) > 0; }), tasks.end());
+	tasks.insert(tasks.end(), added.begin(), added.end());
+
+	// Tasks of the same level do not depend on each other and merging them
+	// cannot create cycles, because all edges point to higher levels
+	topologicalSort(tasks, inEdges, outEdges, ordered);
+	std::unordered_map<Task::Ptr, Int> taskLevels;
+	std::vector<Task::List> levels;
+	for (auto task : ordered) {
+		Int level = 0;
+		for (auto before : inEdges[task])
+			level = std::max(level, taskLevels[before] + 1);
+		taskLevels[task] = level;
+		if (levels.size() <= static_cast<UInt>(level))
+			levels.resize(level + 1);
+		levels[level].push_back(task);
+	}
+
+	removed.clear();
+	added.clear();
+	for (auto& level : levels) {
+		Task::List group;
+		TaskTime groupCost(0);
+		for (auto it = level.begin(); ; ++it) {
+			Bool fits = it != level.end() && isFusible(*it) && groupCost + costs[*it] <= targetCost;
+			if (!fits && group.size() > 1) {
+				added.push_back(contractTasks(group, inEdges, outEdges));
+				removed.insert(group.begin(), group.end());
+			}
+			if (it == level.end())
+				break;
+			if (!fits) {
+				group.clear();
+				groupCost = TaskTime(0);
+				if (!isFusible(*it))
+					continue;
+			}
+			group.push_back(*it);
+			groupCost += costs[*it];
+		}
+	}
+	tasks.erase(std::remove_if(tasks.begin(), tasks.end(),
+		[&removed](const Task::Ptr& task) { return removed.count(task) > 0; }), tasks.end());
+	tasks.insert(tasks.end(), added.begin(), added.end());
+
+	mSLog->info("Coarsened task graph from {:d} to {:d} tasks", numTasks, tasks.size());
+}
+
+Task::Ptr Scheduler::contractTasks(const Task::List& group, Edges& inEdges, Edges& outEdges) {
+	auto composite = std::make_shared<CompositeTask>(group);
+	std::unordered_set<Task::Ptr> members(group.begin(), group.end());
+	auto isMember = [&members](const Task::Ptr& task) { return members.count(task) > 0; };
+
+	std::unordered_set<Task::Ptr> preds, succs;
+	for (auto task : group) {
+		for (auto before : inEdges[task]) {
+			if (!isMember(before) && preds.insert(before).second)
+				inEdges[composite].push_back(before);
+		}
+		for (auto after : outEdges[task]) {
+			if (!isMember(after) && succs.insert(after).second)
+				outEdges[composite].push_back(after);
+		}
+	}
+	for (auto before : preds) {
+		auto& edges = outEdges[before];
+		edges.erase(std::remove_if(edges.begin(), edges.end(), isMember), edges.end());
+		edges.push_back(composite);
+	}
+	for (auto after : succs) {
+		auto& edges = inEdges[after];
+		edges.erase(std::remove_if(edges.begin(), edges.end(), isMember), edges.end());
+		edges.push_back(composite);
+	}
+	for (auto task : group) {
+		inEdges.erase(task);
+		outEdges.erase(task);
+	}
+
+	return composite;
+}
+
 void Scheduler::topologicalSort(const Task::List& tasks, const Edges& inEdges, const Edges& outEdges, Task::List& sortedTasks) {
 	sortedTasks.clear();
 
@@ -171,27 +413,221 @@ void Scheduler::topologicalSort(const Task::List& tasks, const Edges& inEdges, c
 
 }
 
-void Scheduler::levelSchedule(const Task::List& tasks, const Edges& inEdges, const Edges& outEdges, std::vector<Task::List>& levels) {
-	std::unordered_map<Task::Ptr, int> time;
+void Scheduler::compileGraph(const Task::List& tasks, const Edges& inEdges, const Edges& outEdges, TaskGraph& graph) {
+	Task::List ordered;
+	topologicalSort(tasks, inEdges, outEdges, ordered);
+	graph.compile(ordered, inEdges, outEdges);
+}
 
-	for (auto task : tasks) {
-		if (inEdges.find(task) == inEdges.end() || inEdges.at(task).empty()) {
-			time[task] = 0;
-		} else {
-			int maxdist = 0;
-			for (auto before : inEdges.at(task)) {
-				if (time[before] > maxdist)
-					maxdist = time[before];
+void Scheduler::levelSchedule(const TaskGraph& graph, std::vector<Task::List>& levels) {
+	levels.clear();
+	levels.resize(graph.numLevels());
+	for (Int level = 0; level < graph.numLevels(); level++) {
+		for (auto idx = graph.levelBegin(level); idx != graph.levelEnd(level); ++idx)
+			levels[level].push_back(graph.tasks()[*idx]);
+	}
+}
+
+void TaskGraph::compile(const Task::List& sortedTasks, const Scheduler::Edges& inEdges, const Scheduler::Edges& outEdges) {
+	Int n = static_cast<Int>(sortedTasks.size());
+	mTasks = sortedTasks;
+	mTaskPtrs.resize(n);
+	mIndices.clear();
+	for (Int idx = 0; idx < n; idx++) {
+		mTaskPtrs[idx] = mTasks[idx].get();
+		mIndices[mTaskPtrs[idx]] = idx;
+	}
+
+	// Duplicate edges, which occur if a task modifies several attributes
+	// another task depends on, are stored only once
+	auto compileEdges = [this, n](const Scheduler::Edges& edges, std::vector<Int>& ptr, std::vector<Int>& indices) {
+		std::vector<Int> lastSeen(n, -1);
+		ptr.assign(1, 0);
+		indices.clear();
+		for (Int idx = 0; idx < n; idx++) {
+			auto it = edges.find(mTasks[idx]);
+			if (it != edges.end()) {
+				for (auto& other : it->second) {
+					Int otherIdx = index(other.get());
+					if (otherIdx < 0 || lastSeen[otherIdx] == idx)
+						continue;
+					lastSeen[otherIdx] = idx;
+					indices.push_back(otherIdx);
+				}
 			}
-			time[task] = maxdist + 1;
+			ptr.push_back(static_cast<Int>(indices.size()));
 		}
+	};
+	compileEdges(outEdges, mSuccessorPtr, mSuccessors);
+	compileEdges(inEdges, mPredecessorPtr, mPredecessors);
+
+	mInDegrees.resize(n);
+	mLevels.assign(n, 0);
+	Int numLevels = 0;
+	for (Int idx = 0; idx < n; idx++) {
+		mInDegrees[idx] = mPredecessorPtr[idx + 1] - mPredecessorPtr[idx];
+		for (auto before = predecessorsBegin(idx); before != predecessorsEnd(idx); ++before)
+			mLevels[idx] = std::max(mLevels[idx], mLevels[*before] + 1);
+		numLevels = std::max(numLevels, mLevels[idx] + 1);
 	}
 
-	levels.clear();
-	levels.resize(time[tasks.back()] + 1);
+	mLevelPtr.assign(numLevels + 1, 0);
+	for (auto level : mLevels)
+		mLevelPtr[level + 1]++;
+	for (Int level = 0; level < numLevels; level++)
+		mLevelPtr[level + 1] += mLevelPtr[level];
+	mLevelTasks.resize(n);
+	std::vector<Int> next(mLevelPtr.begin(), mLevelPtr.end() - 1);
+	for (Int idx = 0; idx < n; idx++)
+		mLevelTasks[next[mLevels[idx]]++] = idx;
+}
+
+CompositeTask::CompositeTask(const Task::List& tasks) :
+	Task(tasks.front()->toString() + "+" + std::to_string(tasks.size() - 1)) {
+
+	// Nested composite tasks are flattened
 	for (auto task : tasks) {
-		levels[time[task]].push_back(task);
+		auto composite = std::dynamic_pointer_cast<CompositeTask>(task);
+		if (composite)
+			mTasks.insert(mTasks.end(), composite->mTasks.begin(), composite->mTasks.end());
+		else
+			mTasks.push_back(task);
+	}
+
+	for (auto task : mTasks) {
+		mAttributeDependencies.insert(mAttributeDependencies.end(),
+			task->getAttributeDependencies().begin(), task->getAttributeDependencies().end());
+		mModifiedAttributes.insert(mModifiedAttributes.end(),
+			task->getModifiedAttributes().begin(), task->getModifiedAttributes().end());
+		mPrevStepDependencies.insert(mPrevStepDependencies.end(),
+			task->getPrevStepDependencies().begin(), task->getPrevStepDependencies().end());
+	}
+}
+
+void CompositeTask::execute(Real time, Int timeStepCount) {
+	if (mMeasurements.empty()) {
+		for (auto& task : mTasks)
+			task->execute(time, timeStepCount);
+		return;
+	}
+
+	for (std::size_t idx = 0; idx < mTasks.size(); idx++) {
+		auto start = std::chrono::steady_clock::now();
+		mTasks[idx]->execute(time, timeStepCount);
+		auto end = std::chrono::steady_clock::now();
+		mMeasurements[idx]->add(std::chrono::duration_cast<TimeStatistics::Duration>(end - start));
+	}
+}
+
+template <typename T>
+class MultiRateTask::InterpolationImpl : public MultiRateTask::Interpolation {
+public:
+	InterpolationImpl(std::shared_ptr<Attribute<T>> attr) :
+		mAttribute(attr), mPrevious(attr->get()), mLatest(attr->get()) { }
+
+	void update() {
+		mPrevious = mLatest;
+		mLatest = mAttribute->get();
+	}
+
+	void restore() {
+		T& value = *mAttribute;
+		value = mLatest;
+	}
+
+	void interpolate(Real weight) {
+		T& value = *mAttribute;
+		value = mPrevious + (mLatest - mPrevious) * weight;
 	}
+
+private:
+	std::shared_ptr<Attribute<T>> mAttribute;
+	T mPrevious;
+	T mLatest;
+};
+
+MultiRateTask::MultiRateTask(Task::Ptr task) :
+	Task(task->toString()), mTask(task), mRateDivisor(task->rateDivisor()) {
+	mAttributeDependencies = task->getAttributeDependencies();
+	mModifiedAttributes = task->getModifiedAttributes();
+	mPrevStepDependencies = task->getPrevStepDependencies();
+
+	if (!task->interpolateOutputs())
+		return;
+
+	for (auto attr : mModifiedAttributes) {
+		if (!attr || (attr->flags() & Flags::getter))
+			continue;
+
+		if (auto realAttr = std::dynamic_pointer_cast<Attribute<Real>>(attr))
+			mInterpolations.emplace_back(new InterpolationImpl<Real>(realAttr));
+		else if (auto compAttr = std::dynamic_pointer_cast<Attribute<Complex>>(attr))
+			mInterpolations.emplace_back(new InterpolationImpl<Complex>(compAttr));
+		else if (auto matAttr = std::dynamic_pointer_cast<Attribute<Matrix>>(attr))
+			mInterpolations.emplace_back(new InterpolationImpl<Matrix>(matAttr));
+		else if (auto matCompAttr = std::dynamic_pointer_cast<Attribute<MatrixComp>>(attr))
+			mInterpolations.emplace_back(new InterpolationImpl<MatrixComp>(matCompAttr));
+	}
+}
+
+void MultiRateTask::execute(Real time, Int timeStepCount) {
+	UInt phase = static_cast<UInt>(timeStepCount) % mRateDivisor;
+	if (phase == 0) {
+		for (auto& interp : mInterpolations)
+			interp->restore();
+		mTask->execute(time, timeStepCount);
+		for (auto& interp : mInterpolations)
+			interp->update();
+	}
+
+	for (auto& interp : mInterpolations)
+		interp->interpolate(static_cast<Real>(phase) / mRateDivisor);
+}
+
+static std::atomic<std::chrono::nanoseconds::rep> spinBudget(20000);
+/// Calibrated number of iterations, zero if not yet calibrated
+static std::atomic<Int> spinIterationCount(0);
+
+void AdaptiveWait::setSpinBudget(std::chrono::nanoseconds budget) {
+	spinBudget.store(budget.count(), std::memory_order_relaxed);
+	spinIterationCount.store(0, std::memory_order_relaxed);
+}
+
+Int AdaptiveWait::spinIterations() {
+	Int iterations = spinIterationCount.load(std::memory_order_relaxed);
+	if (iterations > 0)
+		return iterations;
+
+	// Concurrent calibrations are harmless, the last one wins
+	const Int samples = 10000;
+	auto start = std::chrono::steady_clock::now();
+	for (Int i = 0; i < samples; i++)
+		relax();
+	auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now() - start).count();
+
+	iterations = static_cast<Int>(std::min<std::chrono::nanoseconds::rep>(
+		spinBudget.load(std::memory_order_relaxed) * samples / std::max<std::chrono::nanoseconds::rep>(elapsed, 1),
+		std::numeric_limits<Int>::max()));
+	iterations = std::max(iterations, 1);
+	spinIterationCount.store(iterations, std::memory_order_relaxed);
+	return iterations;
+}
+
+void AdaptiveWait::park(std::atomic<Int>& word, Int expected) {
+#ifdef __linux__
+	static_assert(sizeof(std::atomic<Int>) == sizeof(int), "futex requires a plain int");
+	// Returns immediately if the word does not have the expected value anymore
+	syscall(SYS_futex, reinterpret_cast<int*>(&word), FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+#else
+	std::this_thread::yield();
+#endif
+}
+
+void AdaptiveWait::wakeAll(std::atomic<Int>& word) {
+#ifdef __linux__
+	syscall(SYS_futex, reinterpret_cast<int*>(&word), FUTEX_WAKE_PRIVATE, std::numeric_limits<int>::max(), nullptr, nullptr, 0);
+#endif
 }
 
 void BarrierTask::addBarrier(Barrier* b) {
@@ -22,23 +22,25 @@ using namespace DPsim;
 void SequentialScheduler::createSchedule(const Task::List& tasks, const Edges& inEdges, const Edges& outEdges) {
 	if (mOutMeasurementFile.size() != 0)
 		Scheduler::initMeasurements(tasks);
-	Scheduler::topologicalSort(tasks, inEdges, outEdges, mSchedule);
+	Scheduler::compileGraph(tasks, inEdges, outEdges, mGraph);
+	// All tasks are executed by the thread calling step
+	configureThread(0);
 
-	for (auto task : mSchedule)
+	for (auto task : mGraph.tasks())
         mSLog->info("{}", task->toString());
 }
 
 void SequentialScheduler::step(Real time, Int timeStepCount) {
 	if (mOutMeasurementFile.size() != 0) {
-		for (auto task : mSchedule) {
+		for (Int idx = 0; idx < mGraph.size(); idx++) {
 			auto start = std::chrono::steady_clock::now();
-			task->execute(time, timeStepCount);
+			mGraph.task(idx)->execute(time, timeStepCount);
 			auto end = std::chrono::steady_clock::now();
-			updateMeasurement(task.get(), end-start);
+			updateMeasurement(mGraph.task(idx), end-start);
 		}
 	} else {
-		for (auto it : mSchedule) {
-			it->execute(time, timeStepCount);
+		for (Int idx = 0; idx < mGraph.size(); idx++) {
+			mGraph.task(idx)->execute(time, timeStepCount);
 		}
 	}
 }
@@ -25,6 +25,7 @@
 #include <cps/Utils.h>
 #include <dpsim/MNASolver.h>
 #include <dpsim/MNASolverSysRecomp.h>
+#include <dpsim/MNASolverEnsemble.h>
 #include <dpsim/PFSolverPowerPolar.h>
 #include <dpsim/DiakopticsSolver.h>
 
@@ -110,6 +111,10 @@ void Simulation::initialize() {
 
 	schedule();
 
+	// Start the loggers outside of the simulation steps
+	for (auto logger : mLoggers)
+		logger->start();
+
 	mInitialized = true;
 }
 
@@ -155,6 +160,39 @@ template <typename VarType>
 void Simulation::createMNASolver() {
 	Solver::Ptr solver;
 	std::vector<SystemTopology> subnets;
+
+	if (mScenarioSystems.size() > 0) {
+		// Scenarios share the factorization, which neither the diakoptics
+		// solver nor the recomputation of the system matrix provide
+		if (mTearComponents.size() > 0)
+			throw SystemError("Scenarios cannot be combined with tear components.");
+		if (mSystemMatrixRecomputation)
+			throw SystemError("Scenarios cannot be combined with system matrix recomputation.");
+		if (mSplitSubnets)
+			mLog->info("Scenarios are not split into subnets");
+
+		auto ensemble = std::make_shared<MnaSolverEnsemble<VarType>>(
+			mName, mDomain, mLogLevel);
+		ensemble->setTimeStep(mTimeStep);
+		ensemble->doSteadyStateInit(mSteadyStateInit);
+		ensemble->doFrequencyParallelization(mFreqParallel);
+		ensemble->setSwitchCacheSize(mSwitchCacheSize);
+		ensemble->doSwitchLowRankUpdate(mSwitchLowRankUpdate, mSwitchMaxUpdateRank);
+		ensemble->doComplexSparseSolve(mComplexSparseSolve);
+		ensemble->doLevelScheduledSolve(mLevelScheduledSolve);
+		ensemble->setSteadStIniTimeLimit(mSteadStIniTimeLimit);
+		ensemble->setSteadStIniAccLimit(mSteadStIniAccLimit);
+		ensemble->setNodeOrdering(mNodeOrdering);
+		ensemble->doVectorLogging(mVectorLogDownsampling > 0, mVectorLogDownsampling);
+		ensemble->setVectorLogNodes(mVectorLogNodeNames);
+		ensemble->setVectorLogNodes(mVectorLogNodeIndices);
+		ensemble->setSystem(mSystem);
+		ensemble->setScenarios(mScenarioSystems);
+		ensemble->initialize();
+		mSolvers.push_back(ensemble);
+		return;
+	}
+
 	// The Diakoptics solver splits the system at a later point.
 	// That is why the system is not split here if tear components exist.
 	if (mSplitSubnets && mTearComponents.size() == 0)
@@ -173,6 +211,9 @@ void Simulation::createMNASolver() {
 			// Tear components available, use diakoptics
 			solver = std::make_shared<DiakopticsSolver<VarType>>(mName,
 				subnets[net], mTearComponents, mTimeStep, mLogLevel);
+			solver->doVectorLogging(mVectorLogDownsampling > 0, mVectorLogDownsampling);
+			solver->setVectorLogNodes(mVectorLogNodeNames);
+			solver->setVectorLogNodes(mVectorLogNodeIndices);
 		}
 		else if (mSystemMatrixRecomputation) {
 			// Recompute system matrix if switches or other components change
@@ -182,6 +223,10 @@ void Simulation::createMNASolver() {
 			solver->doSteadyStateInit(mSteadyStateInit);
 			solver->setSteadStIniTimeLimit(mSteadStIniTimeLimit);
 			solver->setSteadStIniAccLimit(mSteadStIniAccLimit);
+			solver->setNodeOrdering(mNodeOrdering);
+			solver->doVectorLogging(mVectorLogDownsampling > 0, mVectorLogDownsampling);
+			solver->setVectorLogNodes(mVectorLogNodeNames);
+			solver->setVectorLogNodes(mVectorLogNodeIndices);
 			solver->setSystem(subnets[net]);
 			solver->initialize();
 		}
@@ -197,8 +242,16 @@ void Simulation::createMNASolver() {
 			solver->setTimeStep(mTimeStep);
 			solver->doSteadyStateInit(mSteadyStateInit);
 			solver->doFrequencyParallelization(mFreqParallel);
+			solver->setSwitchCacheSize(mSwitchCacheSize);
+			solver->doSwitchLowRankUpdate(mSwitchLowRankUpdate, mSwitchMaxUpdateRank);
+			solver->setNodeOrdering(mNodeOrdering);
+			solver->doComplexSparseSolve(mComplexSparseSolve);
+			solver->doLevelScheduledSolve(mLevelScheduledSolve);
 			solver->setSteadStIniTimeLimit(mSteadStIniTimeLimit);
 			solver->setSteadStIniAccLimit(mSteadStIniAccLimit);
+			solver->doVectorLogging(mVectorLogDownsampling > 0, mVectorLogDownsampling);
+			solver->setVectorLogNodes(mVectorLogNodeNames);
+			solver->setVectorLogNodes(mVectorLogNodeIndices);
 			solver->setSystem(subnets[net]);
 			solver->initialize();
 		}
@@ -247,10 +300,22 @@ void Simulation::prepSchedule() {
 	for (auto logger : mLoggers) {
 		mTasks.push_back(logger->getTask());
 	}
+	mPipeline.reset();
+	if (mPipelinedLogging) {
+		mPipeline.reset(new TaskPipeline(mPipelineBufferSize));
+		for (auto& task : mTasks) {
+			auto pipelinedTask = std::dynamic_pointer_cast<PipelinedTask>(task);
+			if (pipelinedTask)
+				task = mPipeline->addTask(pipelinedTask);
+		}
+	}
 	if (!mScheduler) {
 		mScheduler = std::make_shared<SequentialScheduler>();
 	}
 	mScheduler->resolveDeps(mTasks, mTaskInEdges, mTaskOutEdges);
+	if (mTaskCoarsening)
+		mScheduler->coarsenTasks(mTasks, mTaskInEdges, mTaskOutEdges,
+			mCoarseningTargetCost, mCoarseningMeasurementFile);
 }
 
 void Simulation::schedule() {
@@ -400,6 +465,7 @@ void Simulation::run() {
 	}
 
 	mScheduler->stop();
+	stopPipeline();
 
 #ifdef WITH_SHMEM
 	for (auto ifm : mInterfaces)
@@ -416,14 +482,23 @@ Real Simulation::step() {
 	auto start = std::chrono::steady_clock::now();
 	mEvents.handleEvents(mTime);
 
-	mScheduler->step(mTime, mTimeStepCount);
+	if (mPipeline) {
+		mPipeline->beginStep();
+		mScheduler->step(mTime, mTimeStepCount);
+		mPipeline->endStep();
+	} else {
+		mScheduler->step(mTime, mTimeStepCount);
+	}
 
 	mTime += mTimeStep;
 	mTimeStepCount++;
 
 	auto end = std::chrono::steady_clock::now();
-	std::chrono::duration<double> diff = end-start;
-	mStepTimes.push_back(diff.count());
+	mStepTimeStatistics.add(std::chrono::duration_cast<TimeStatistics::Duration>(end-start));
+	if (mStepTimeRecording) {
+		std::chrono::duration<double> diff = end-start;
+		mStepTimes.push_back(diff.count());
+	}
 	return mTime;
 }
 
@@ -442,12 +517,20 @@ void Simulation::reset() {
 void Simulation::logStepTimes(String logName) {
 	auto stepTimeLog = Logger::get(logName, Logger::Level::info);
 	Logger::setLogPattern(stepTimeLog, "%v");
-	stepTimeLog->info("step_time");
 
-	Real stepTimeSum = 0;
-	for (auto meas : mStepTimes) {
-		stepTimeSum += meas;
-		stepTimeLog->info("{:f}", meas);
+	auto seconds = [](TimeStatistics::Duration time) {
+		return std::chrono::duration<Real>(time).count();
+	};
+	if (mStepTimeRecording) {
+		stepTimeLog->info("step_time");
+		for (auto meas : mStepTimes)
+			stepTimeLog->info("{:f}", meas);
+	} else {
+		stepTimeLog->info("count,mean,min,max,p50,p99,p999");
+		stepTimeLog->info("{:d},{:f},{:f},{:f},{:f},{:f},{:f}", mStepTimeStatistics.count(),
+			seconds(mStepTimeStatistics.mean()), seconds(mStepTimeStatistics.min()),
+			seconds(mStepTimeStatistics.max()), seconds(mStepTimeStatistics.percentile(0.5)),
+			seconds(mStepTimeStatistics.percentile(0.99)), seconds(mStepTimeStatistics.percentile(0.999)));
 	}
-	mLog->info("Average step time: {:.6f}", stepTimeSum / mStepTimes.size());
+	mLog->info("Average step time: {:.6f}", seconds(mStepTimeStatistics.mean()));
 }
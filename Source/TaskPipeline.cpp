@@ -0,0 +1,95 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim/TaskPipeline.h>
+
+using namespace CPS;
+using namespace DPsim;
+
+TaskPipeline::TaskPipeline(UInt bufferSize) : mBufferSize(bufferSize) {
+	if (bufferSize < 1)
+		throw SchedulingException();
+}
+
+TaskPipeline::~TaskPipeline() {
+	stop();
+}
+
+Task::Ptr TaskPipeline::addTask(PipelinedTask::Ptr task) {
+	task->setBufferSize(mBufferSize);
+	mTasks.push_back(task);
+	return std::make_shared<SnapshotTask>(task, *this);
+}
+
+void TaskPipeline::beginStep() {
+	std::unique_lock<std::mutex> lk(mMutex);
+	if (!mThread.joinable()) {
+		mStopping = false;
+		mThread = std::thread(&TaskPipeline::threadFunction, this);
+	}
+
+	while (mSubmitted - mProcessed >= mBufferSize)
+		mCondition.wait(lk);
+	mCurrentSlot = mSubmitted % mBufferSize;
+}
+
+void TaskPipeline::endStep() {
+	{
+		std::lock_guard<std::mutex> lk(mMutex);
+		mSubmitted++;
+	}
+	mCondition.notify_all();
+}
+
+void TaskPipeline::flush() {
+	std::unique_lock<std::mutex> lk(mMutex);
+	while (mProcessed != mSubmitted && mThread.joinable())
+		mCondition.wait(lk);
+}
+
+void TaskPipeline::stop() {
+	{
+		std::lock_guard<std::mutex> lk(mMutex);
+		mStopping = true;
+	}
+	mCondition.notify_all();
+	if (mThread.joinable())
+		mThread.join();
+}
+
+void TaskPipeline::threadFunction() {
+	std::unique_lock<std::mutex> lk(mMutex);
+	while (true) {
+		while (mProcessed == mSubmitted && !mStopping)
+			mCondition.wait(lk);
+		if (mProcessed == mSubmitted)
+			return;
+
+		// The slot cannot be reused before mProcessed is increased,
+		// so it can be processed without holding the lock
+		UInt slot = mProcessed % mBufferSize;
+		lk.unlock();
+		for (auto& task : mTasks)
+			task->process(slot);
+		lk.lock();
+
+		mProcessed++;
+		mCondition.notify_all();
+	}
+}
+
+TaskPipeline::SnapshotTask::SnapshotTask(PipelinedTask::Ptr task, TaskPipeline& pipeline) :
+	Task(task->toString()), mTask(task), mPipeline(pipeline) {
+	mAttributeDependencies = task->getAttributeDependencies();
+	mModifiedAttributes = task->getModifiedAttributes();
+	mPrevStepDependencies = task->getPrevStepDependencies();
+}
+
+void TaskPipeline::SnapshotTask::execute(Real time, Int timeStepCount) {
+	mTask->snapshot(time, timeStepCount, mPipeline.currentSlot());
+}
@@ -0,0 +1,121 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim/ThreadHEFTScheduler.h>
+
+#include <algorithm>
+#include <numeric>
+
+using namespace CPS;
+using namespace DPsim;
+
+ThreadHEFTScheduler::ThreadHEFTScheduler(Int threads, String outMeasurementFile, String inMeasurementFile, Bool useConditionVariables, TaskTime syncCost) :
+	ThreadScheduler(threads, outMeasurementFile, useConditionVariables), mInMeasurementFile(inMeasurementFile), mSyncCost(syncCost) {
+}
+
+void ThreadHEFTScheduler::createSchedule(const Task::List& tasks, const Edges& inEdges, const Edges& outEdges) {
+	Scheduler::compileGraph(tasks, inEdges, outEdges, mGraph);
+	Scheduler::initMeasurements(mGraph.tasks(), !mOutMeasurementFile.empty());
+
+	// Without measurements all tasks are assumed to take the same time
+	std::vector<TaskTime::rep> costs(mGraph.size(), TaskTime(std::chrono::microseconds(1)).count());
+	if (!mInMeasurementFile.empty()) {
+		std::unordered_map<String, TaskTime::rep> measurements;
+		readMeasurements(mInMeasurementFile, measurements);
+		addCompositeMeasurements(mGraph.tasks(), measurements);
+
+		// Check that measurements map is complete
+		for (Int idx = 0; idx < mGraph.size(); idx++) {
+			auto it = measurements.find(mGraph.task(idx)->toString());
+			if (it == measurements.end())
+				throw SchedulingException();
+			costs[idx] = std::max<TaskTime::rep>(it->second, 0);
+		}
+	}
+	TaskTime::rep syncCost = mSyncCost.count();
+
+	// Upward rank: cost of the task plus the longest path to the end of the step,
+	// assuming that each dependency crosses threads
+	std::vector<TaskTime::rep> ranks(mGraph.size(), 0);
+	for (Int idx = mGraph.size() - 1; idx >= 0; idx--) {
+		TaskTime::rep maxRank = 0;
+		for (auto after = mGraph.successorsBegin(idx); after != mGraph.successorsEnd(idx); ++after)
+			maxRank = std::max(maxRank, syncCost + ranks[*after]);
+		ranks[idx] = costs[idx] + maxRank;
+	}
+
+	// Sorting by decreasing rank yields a topological order, ties are
+	// broken by the original order for tasks without cost
+	std::vector<Int> order(mGraph.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(), [&ranks](Int idx1, Int idx2) {
+		return ranks[idx1] > ranks[idx2];
+	});
+
+	// Threads execute their tasks in the order they are scheduled,
+	// so tasks can only be appended to the end of a thread
+	std::vector<TaskTime::rep> threadEnd(mNumThreads, 0);
+	std::vector<TaskTime::rep> finishTimes(mGraph.size(), 0);
+	std::vector<Int> threadOf(mGraph.size(), 0);
+	for (auto idx : order) {
+		auto task = mGraph.tasks()[idx];
+
+		// Parallel tasks are executed by all threads at once
+		if (std::dynamic_pointer_cast<ParallelTask>(task)) {
+			TaskTime::rep start = *std::max_element(threadEnd.begin(), threadEnd.end());
+			for (auto before = mGraph.predecessorsBegin(idx); before != mGraph.predecessorsEnd(idx); ++before)
+				start = std::max(start, finishTimes[*before] + syncCost);
+			finishTimes[idx] = start + costs[idx];
+			std::fill(threadEnd.begin(), threadEnd.end(), finishTimes[idx]);
+			scheduleTask(0, task);
+			continue;
+		}
+
+		Int bestThread = 0;
+		TaskTime::rep bestFinish = 0;
+		for (Int thread = 0; thread < mNumThreads; thread++) {
+			TaskTime::rep start = threadEnd[thread];
+			for (auto before = mGraph.predecessorsBegin(idx); before != mGraph.predecessorsEnd(idx); ++before) {
+				TaskTime::rep ready = finishTimes[*before];
+				if (threadOf[*before] != thread)
+					ready += syncCost;
+				start = std::max(start, ready);
+			}
+			if (thread == 0 || start + costs[idx] < bestFinish) {
+				bestThread = thread;
+				bestFinish = start + costs[idx];
+			}
+		}
+
+		finishTimes[idx] = bestFinish;
+		threadOf[idx] = bestThread;
+		threadEnd[bestThread] = bestFinish;
+		scheduleTask(bestThread, task);
+	}
+
+	mPredictedStepTime = TaskTime(*std::max_element(threadEnd.begin(), threadEnd.end()));
+	mSLog->info("Predicted step time: {:d} ns",
+		std::chrono::duration_cast<std::chrono::nanoseconds>(mPredictedStepTime).count());
+
+	ThreadScheduler::finishSchedule();
+}
+
+void ThreadHEFTScheduler::step(Real time, Int timeStepCount) {
+	auto start = std::chrono::steady_clock::now();
+	ThreadScheduler::step(time, timeStepCount);
+	mTotalStepTime += std::chrono::steady_clock::now() - start;
+	mNumSteps++;
+}
+
+void ThreadHEFTScheduler::stop() {
+	ThreadScheduler::stop();
+
+	mSLog->info("Predicted step time: {:d} ns, achieved average step time: {:d} ns",
+		std::chrono::duration_cast<std::chrono::nanoseconds>(mPredictedStepTime).count(),
+		std::chrono::duration_cast<std::chrono::nanoseconds>(averageStepTime()).count());
+}
@@ -20,20 +20,20 @@ ThreadLevelScheduler::ThreadLevelScheduler(Int threads, String outMeasurementFil
 }
 
 void ThreadLevelScheduler::createSchedule(const Task::List& tasks, const Edges& inEdges, const Edges& outEdges) {
-	Task::List ordered;
 	std::vector<Task::List> levels;
 
-	Scheduler::topologicalSort(tasks, inEdges, outEdges, ordered);
-	Scheduler::initMeasurements(ordered);
+	Scheduler::compileGraph(tasks, inEdges, outEdges, mGraph);
+	Scheduler::initMeasurements(mGraph.tasks(), !mOutMeasurementFile.empty());
 
-	Scheduler::levelSchedule(ordered, inEdges, outEdges, levels);
+	Scheduler::levelSchedule(mGraph, levels);
 
 	if (!mInMeasurementFile.empty()) {
 		std::unordered_map<String, TaskTime::rep> measurements;
 		readMeasurements(mInMeasurementFile, measurements);
+		addCompositeMeasurements(mGraph.tasks(), measurements);
 		for (size_t level = 0; level < levels.size(); level++) {
 			// Distribute tasks such that the execution time is (approximately) minimized
-			scheduleLevel(levels[level], measurements, inEdges);
+			scheduleLevel(levels[level], measurements);
 		}
 	} else {
 		for (size_t level = 0; level < levels.size(); level++) {
@@ -49,7 +49,7 @@ void ThreadLevelScheduler::createSchedule(const Task::List& tasks, const Edges&
 		}
 	}
 
-	ThreadScheduler::finishSchedule(inEdges);
+	ThreadScheduler::finishSchedule();
 }
 
 void ThreadLevelScheduler::sortTasksByType(Task::List::iterator begin, CPS::Task::List::iterator end) {
@@ -69,7 +69,7 @@ void ThreadLevelScheduler::sortTasksByType(Task::List::iterator begin, CPS::Task
 	std::sort(begin, end, cmp);
 }
 
-void ThreadLevelScheduler::scheduleLevel(const Task::List& tasks, const std::unordered_map<String, TaskTime::rep>& measurements, const Edges& inEdges) {
+void ThreadLevelScheduler::scheduleLevel(const Task::List& tasks, const std::unordered_map<String, TaskTime::rep>& measurements) {
 	Task::List tasksSorted = tasks;
 
 	// Check that measurements map is complete
@@ -18,79 +18,62 @@ ThreadListScheduler::ThreadListScheduler(Int threads, String outMeasurementFile,
 }
 
 void ThreadListScheduler::createSchedule(const Task::List& tasks, const Edges& inEdges, const Edges& outEdges) {
-	Task::List ordered;
+	Scheduler::compileGraph(tasks, inEdges, outEdges, mGraph);
+	Scheduler::initMeasurements(mGraph.tasks(), !mOutMeasurementFile.empty());
 
-	Scheduler::topologicalSort(tasks, inEdges, outEdges, ordered);
-	Scheduler::initMeasurements(ordered);
-
-	std::unordered_map<Task::Ptr, int64_t> priorities;
-	std::unordered_map<String, TaskTime::rep> measurements;
+	std::vector<TaskTime::rep> costs(mGraph.size(), 1);
 	if (!mInMeasurementFile.empty()) {
+		std::unordered_map<String, TaskTime::rep> measurements;
 		readMeasurements(mInMeasurementFile, measurements);
+		addCompositeMeasurements(mGraph.tasks(), measurements);
 
 		// Check that measurements map is complete
-		for (auto task : ordered) {
-			if (measurements.find(task->toString()) == measurements.end())
+		for (Int idx = 0; idx < mGraph.size(); idx++) {
+			auto it = measurements.find(mGraph.task(idx)->toString());
+			if (it == measurements.end())
 				throw SchedulingException();
-		}
-	} else {
-		// Insert constant cost for each task (HLFNET)
-		for (auto task : ordered) {
-			measurements[task->toString()] = 1;
+			costs[idx] = it->second;
 		}
 	}
+	// Otherwise a constant cost is used for each task (HLFNET)
 
 	// HLFET
-	for (auto it = ordered.rbegin(); it != ordered.rend(); ++it) {
-		auto task = *it;
+	std::vector<int64_t> priorities(mGraph.size(), 0);
+	for (Int idx = mGraph.size() - 1; idx >= 0; idx--) {
 		int64_t maxLevel = 0;
-		if (outEdges.find(task) != outEdges.end()) {
-			for (auto dep : outEdges.at(task)) {
-				if (priorities[dep] > maxLevel) {
-					maxLevel = priorities[dep];
-				}
+		for (auto after = mGraph.successorsBegin(idx); after != mGraph.successorsEnd(idx); ++after) {
+			if (priorities[*after] > maxLevel) {
+				maxLevel = priorities[*after];
 			}
 		}
-		priorities[task] = measurements.at(task->toString()) + maxLevel;
+		priorities[idx] = costs[idx] + maxLevel;
 	}
 
-	auto cmp = [&priorities](const Task::Ptr& p1, const Task::Ptr& p2) -> bool {
-		return priorities[p1] < priorities[p2];
+	auto cmp = [&priorities](Int idx1, Int idx2) -> bool {
+		return priorities[idx1] < priorities[idx2];
 	};
-	std::priority_queue<Task::Ptr, std::deque<Task::Ptr>, decltype(cmp)> queue(cmp);
-	for (auto task : ordered) {
-		if (inEdges.find(task) == inEdges.end() || inEdges.at(task).empty()) {
-			queue.push(task);
-		} else {
-			break;
-		}
+	std::priority_queue<Int, std::vector<Int>, decltype(cmp)> queue(cmp);
+	std::vector<Int> pendingInDegrees = mGraph.inDegrees();
+	for (Int idx = 0; idx < mGraph.size(); idx++) {
+		if (pendingInDegrees[idx] == 0)
+			queue.push(idx);
 	}
 
 	std::vector<TaskTime::rep> totalTimes(mNumThreads, 0);
-	Edges inEdgesCpy = inEdges;
 	while (!queue.empty()) {
-		auto task = queue.top();
+		Int idx = queue.top();
 		queue.pop();
 
 		auto minIt = std::min_element(totalTimes.begin(), totalTimes.end());
 		Int minIdx = static_cast<UInt>(minIt - totalTimes.begin());
-		scheduleTask(minIdx, task);
-		totalTimes[minIdx] += measurements.at(task->toString());
+		scheduleTask(minIdx, mGraph.tasks()[idx]);
+		totalTimes[minIdx] += costs[idx];
 
-		if (outEdges.find(task) != outEdges.end()) {
-			for (auto after : outEdges.at(task)) {
-				for (auto edgeIt = inEdgesCpy[after].begin(); edgeIt != inEdgesCpy[after].end(); ++edgeIt) {
-					if (*edgeIt == task) {
-						inEdgesCpy[after].erase(edgeIt);
-						break;
-					}
-				}
-				if (inEdgesCpy[after].empty() && std::find(ordered.begin(), ordered.end(), after) != ordered.end()) {
-					queue.push(after);
-				}
-			}
+		for (auto after = mGraph.successorsBegin(idx); after != mGraph.successorsEnd(idx); ++after) {
+			if (--pendingInDegrees[*after] == 0)
+				queue.push(*after);
 		}
 	}
 
-	ThreadScheduler::finishSchedule(inEdges);
+	ThreadScheduler::finishSchedule();
 }
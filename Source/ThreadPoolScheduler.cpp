@@ -0,0 +1,89 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim/ThreadPoolScheduler.h>
+
+using namespace CPS;
+using namespace DPsim;
+
+void ThreadPoolScheduler::TaskQueue::init(std::size_t capacity) {
+	std::size_t size = 2;
+	while (size < capacity)
+		size *= 2;
+
+	mCells.reset(new Cell[size]);
+	for (std::size_t i = 0; i < size; i++)
+		mCells[i].sequence.store(i, std::memory_order_relaxed);
+	mMask = size - 1;
+	mHead.store(0, std::memory_order_relaxed);
+	mTail.store(0, std::memory_order_relaxed);
+}
+
+Bool ThreadPoolScheduler::TaskQueue::push(Int task) {
+	Cell* cell;
+	std::size_t pos = mTail.load(std::memory_order_relaxed);
+	while (true) {
+		cell = &mCells[pos & mMask];
+		std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+		auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+		if (diff == 0) {
+			if (mTail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+				break;
+		}
+		else if (diff < 0) {
+			return false;
+		}
+		else {
+			pos = mTail.load(std::memory_order_relaxed);
+		}
+	}
+	cell->task = task;
+	cell->sequence.store(pos + 1, std::memory_order_release);
+	return true;
+}
+
+Bool ThreadPoolScheduler::TaskQueue::pop(Int& task) {
+	Cell* cell;
+	std::size_t pos = mHead.load(std::memory_order_relaxed);
+	while (true) {
+		cell = &mCells[pos & mMask];
+		std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+		auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1);
+		if (diff == 0) {
+			if (mHead.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+				break;
+		}
+		else if (diff < 0) {
+			return false;
+		}
+		else {
+			pos = mHead.load(std::memory_order_relaxed);
+		}
+	}
+	task = cell->task;
+	cell->sequence.store(pos + mMask + 1, std::memory_order_release);
+	return true;
+}
+
+ThreadPoolScheduler::ThreadPoolScheduler(Int threads, String outMeasurementFile) :
+	DynamicThreadScheduler(threads, outMeasurementFile) { }
+
+void ThreadPoolScheduler::initReadyTasks() {
+	// Every task is pushed once per step, so the queue never overflows
+	mReadyTasks.init(mGraph.size());
+}
+
+void ThreadPoolScheduler::pushReadyTask(Int thread, Int task) {
+	// All threads share the queue
+	if (!mReadyTasks.push(task))
+		throw SchedulingException();
+}
+
+Bool ThreadPoolScheduler::popReadyTask(Int thread, Int& task) {
+	return mReadyTasks.pop(task);
+}
@@ -14,7 +14,8 @@ using namespace CPS;
 using namespace DPsim;
 
 ThreadScheduler::ThreadScheduler(Int threads, String outMeasurementFile, Bool useConditionVariable) :
-	mNumThreads(threads), mOutMeasurementFile(outMeasurementFile), mStartBarrier(threads, useConditionVariable) {
+	mNumThreads(threads), mOutMeasurementFile(outMeasurementFile), mStartBarrier(threads, useConditionVariable),
+	mWaitMode(useConditionVariable ? WaitMode::Condition : WaitMode::Spin) {
 	if (threads < 1)
 		throw SchedulingException();
 	mTempSchedules.resize(threads);
@@ -27,11 +28,20 @@ ThreadScheduler::~ThreadScheduler() {
 }
 
 void ThreadScheduler::scheduleTask(int thread, CPS::Task::Ptr task) {
-	mTempSchedules[thread].push_back(task);
+	// Parallel tasks are scheduled on all threads. As the tasks are scheduled
+	// in topological order, all threads reach the task without waiting for
+	// each other.
+	if (std::dynamic_pointer_cast<ParallelTask>(task)) {
+		for (auto& schedule : mTempSchedules)
+			schedule.push_back(task);
+	}
+	else {
+		mTempSchedules[thread].push_back(task);
+	}
 }
 
-void ThreadScheduler::finishSchedule(const Edges& inEdges) {
-	std::map<CPS::Task::Ptr, Counter*> counters;
+void ThreadScheduler::finishSchedule() {
+	std::vector<std::vector<Counter*>> counters(mGraph.size());
 	for (int thread = 0; thread < mNumThreads; thread++) {
 	//	std::cout << "Thread " << thread << std::endl;
 	//	for (auto& entry : mSchedules[thread]) {
@@ -43,23 +53,38 @@ void ThreadScheduler::finishSchedule(const Edges& inEdges) {
 		mSchedules[thread] = new ScheduleEntry[mTempSchedules[thread].size()];
 		for (size_t i = 0; i < mTempSchedules[thread].size(); i++) {
 			auto& task = mTempSchedules[thread][i];
+			auto parallelTask = std::dynamic_pointer_cast<ParallelTask>(task);
 			mSchedules[thread][i].task = task.get();
-			counters[task] = &mSchedules[thread][i].endCounter;
+			mSchedules[thread][i].endCounter.setWaitMode(mWaitMode);
+			mSchedules[thread][i].parallelTask = parallelTask.get();
+			counters[mGraph.index(task.get())].push_back(&mSchedules[thread][i].endCounter);
+			if (parallelTask && thread == 0)
+				parallelTask->setNumThreads(mNumThreads, mWaitMode);
 		}
 	}
 	for (int thread = 0; thread < mNumThreads; thread++) {
 		for (size_t i = 0; i < mTempSchedules[thread].size(); i++) {
-			auto& task = mTempSchedules[thread][i];
-			if (inEdges.find(task) != inEdges.end()) {
-				for (auto req : inEdges.at(task)) {
-					mSchedules[thread][i].reqCounters.push_back(counters[req]);
-				}
+			Int idx = mGraph.index(mTempSchedules[thread][i].get());
+			for (auto req = mGraph.predecessorsBegin(idx); req != mGraph.predecessorsEnd(idx); ++req) {
+				for (auto counter : counters[*req])
+					mSchedules[thread][i].reqCounters.push_back(counter);
 			}
 		}
 	}
+	// The calling thread is configured first so that missing privileges
+	// are reported before any thread is started
+	configureThread(0);
 	for (int i = 1; i < mNumThreads; i++) {
 		mThreads.emplace_back(threadFunction, this, i);
 	}
+	try {
+		for (int i = 1; i < mNumThreads; i++)
+			configureThread(i, &mThreads[i-1]);
+	}
+	catch (...) {
+		stop();
+		throw;
+	}
 }
 
 void ThreadScheduler::step(Real time, Int timeStepCount) {
@@ -82,10 +107,34 @@ void ThreadScheduler::stop() {
 		for (size_t thread = 0; thread < mThreads.size(); thread++) {
 			mThreads[thread].join();
 		}
+		mThreads.clear();
 	}
 	if (!mOutMeasurementFile.empty()) {
 		writeMeasurements(mOutMeasurementFile);
 	}
+	if (mWaitMode == WaitMode::Adaptive) {
+		std::uint64_t spins, parks;
+		waitStatistics(spins, parks);
+		mSLog->info("Adaptive waits: {} finished spinning, {} parked", spins, parks);
+	}
+}
+
+void ThreadScheduler::setWaitMode(WaitMode mode) {
+	mWaitMode = mode;
+	mStartBarrier.setWaitMode(mode);
+}
+
+void ThreadScheduler::waitStatistics(std::uint64_t& spins, std::uint64_t& parks) const {
+	spins = mStartBarrier.waitStatistics().spins();
+	parks = mStartBarrier.waitStatistics().parks();
+	for (int thread = 0; thread < mNumThreads; thread++) {
+		if (!mSchedules[thread])
+			continue;
+		for (size_t i = 0; i < mTempSchedules[thread].size(); i++) {
+			spins += mSchedules[thread][i].endCounter.waitStatistics().spins();
+			parks += mSchedules[thread][i].endCounter.waitStatistics().parks();
+		}
+	}
 }
 
 void ThreadScheduler::threadFunction(ThreadScheduler* sched, Int idx) {
@@ -104,7 +153,10 @@ void ThreadScheduler::doStep(Int thread) {
 			ScheduleEntry* entry = &mSchedules[thread][i];
 			for (Counter* counter : entry->reqCounters)
 				counter->wait(mTimeStepCount+1);
-			entry->task->execute(mTime, mTimeStepCount);
+			if (entry->parallelTask)
+				entry->parallelTask->executeThread(mTime, mTimeStepCount, thread);
+			else
+				entry->task->execute(mTime, mTimeStepCount);
 			entry->endCounter.inc();
 		}
 	} else {
@@ -113,9 +165,14 @@ void ThreadScheduler::doStep(Int thread) {
 			for (Counter* counter : entry->reqCounters)
 				counter->wait(mTimeStepCount+1);
 			auto start = std::chrono::steady_clock::now();
-			entry->task->execute(mTime, mTimeStepCount);
+			if (entry->parallelTask)
+				entry->parallelTask->executeThread(mTime, mTimeStepCount, thread);
+			else
+				entry->task->execute(mTime, mTimeStepCount);
 			auto end = std::chrono::steady_clock::now();
-			updateMeasurement(entry->task, end-start);
+			// Parallel tasks are measured only once
+			if (!entry->parallelTask || thread == 0)
+				updateMeasurement(entry->task, end-start);
 			entry->endCounter.inc();
 		}
 	}
@@ -0,0 +1,83 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+
+#include <dpsim/TimeStatistics.h>
+
+using namespace DPsim;
+
+TimeStatistics::TimeStatistics() :
+	mBuckets(bucketIndex((uint64_t(1) << mMaxBits) - 1) + 1, 0) {
+}
+
+Int TimeStatistics::bucketIndex(uint64_t value) {
+	// Values below 2^(mSubBucketBits+1) have their own bucket. Above, each
+	// power of two is split into 2^mSubBucketBits buckets of equal width.
+	Int msb = 0;
+	while (msb < 63 && (value >> (msb + 1)) != 0)
+		msb++;
+	Int shift = std::max(0, msb - mSubBucketBits);
+	return (shift << mSubBucketBits) + static_cast<Int>(value >> shift);
+}
+
+uint64_t TimeStatistics::bucketValue(Int index) {
+	Int subBuckets = 1 << mSubBucketBits;
+	if (index < 2 * subBuckets)
+		return static_cast<uint64_t>(index);
+
+	Int shift = index / subBuckets - 1;
+	uint64_t lower = static_cast<uint64_t>(index % subBuckets + subBuckets) << shift;
+	return lower + (uint64_t(1) << shift) / 2;
+}
+
+void TimeStatistics::add(Duration time) {
+	uint64_t value = time.count() > 0 ? static_cast<uint64_t>(time.count()) : 0;
+
+	if (mCount == 0 || value < mMin)
+		mMin = value;
+	if (value > mMax)
+		mMax = value;
+	mCount++;
+	mSum += static_cast<Real>(value);
+
+	Int index = std::min(bucketIndex(value), static_cast<Int>(mBuckets.size()) - 1);
+	mBuckets[index]++;
+}
+
+void TimeStatistics::reset() {
+	mCount = 0;
+	mSum = 0;
+	mMin = 0;
+	mMax = 0;
+	std::fill(mBuckets.begin(), mBuckets.end(), 0);
+}
+
+TimeStatistics::Duration TimeStatistics::mean() const {
+	if (mCount == 0)
+		return Duration(0);
+	return Duration(static_cast<Duration::rep>(std::llround(mSum / mCount)));
+}
+
+TimeStatistics::Duration TimeStatistics::percentile(Real fraction) const {
+	if (mCount == 0)
+		return Duration(0);
+
+	fraction = std::min(std::max(fraction, 0.), 1.);
+	uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(fraction * mCount)));
+	uint64_t sum = 0;
+	for (Int index = 0; index < static_cast<Int>(mBuckets.size()); index++) {
+		sum += mBuckets[index];
+		if (sum >= rank) {
+			uint64_t value = std::min(std::max(bucketValue(index), mMin), mMax);
+			return Duration(static_cast<Duration::rep>(value));
+		}
+	}
+	return max();
+}
@@ -0,0 +1,45 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim/WorkStealingScheduler.h>
+
+using namespace CPS;
+using namespace DPsim;
+
+WorkStealingScheduler::WorkStealingScheduler(Int threads, String outMeasurementFile) :
+	DynamicThreadScheduler(threads, outMeasurementFile) {
+	mQueues.reset(new TaskQueue[threads]);
+}
+
+void WorkStealingScheduler::pushReadyTask(Int thread, Int task) {
+	std::lock_guard<std::mutex> lock(mQueues[thread].mutex);
+	mQueues[thread].tasks.push_back(task);
+}
+
+Bool WorkStealingScheduler::popReadyTask(Int thread, Int& task) {
+	{
+		std::lock_guard<std::mutex> lock(mQueues[thread].mutex);
+		if (!mQueues[thread].tasks.empty()) {
+			task = mQueues[thread].tasks.back();
+			mQueues[thread].tasks.pop_back();
+			return true;
+		}
+	}
+
+	// Steal the oldest task of the next thread with ready tasks
+	for (Int offset = 1; offset < mNumThreads; offset++) {
+		auto& queue = mQueues[(thread + offset) % mNumThreads];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if (!queue.tasks.empty()) {
+			task = queue.tasks.front();
+			queue.tasks.pop_front();
+			return true;
+		}
+	}
+	return false;
+}
@@ -188,6 +188,15 @@ namespace Flags {
 				throw AccessException();
 		}
 
+		/// Pointer to the stored value for reading it without the overhead
+		/// of getByValue. Returns nullptr if the value is computed by a
+		/// getter or cannot be read.
+		const T* valuePointer() const {
+			if (!(mFlags & Flags::read) || (mFlags & Flags::getter))
+				return nullptr;
+			return mValue;
+		}
+
 		String toString() const {
 			return std::to_string(this->getByValue());
 		}
@@ -421,4 +430,7 @@ namespace Flags {
 
 	template<>
 	String Attribute<Matrix>::toString() const;
+
+	template<>
+	String Attribute<RightVectorStamp>::toString() const;
 }
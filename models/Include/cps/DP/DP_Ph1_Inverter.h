@@ -137,11 +137,11 @@ namespace Ph1 {
 		void mnaInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector);
 		void mnaInitializeHarm(Real omega, Real timeStep, std::vector<Attribute<Matrix>::Ptr> leftVectors);
 		/// Stamps system matrix
-		void mnaApplySystemMatrixStamp(Matrix& systemMatrix);
+		void mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix);
 		void mnaApplySystemMatrixStampHarm(Matrix& systemMatrix, Int freqIdx);
 		/// Stamps right side (source) vector
-		void mnaApplyRightSideVectorStamp(Matrix& rightVector);
-		void mnaApplyRightSideVectorStampHarm(Matrix& rightVector);
+		void mnaApplyRightSideVectorStamp(RightVectorStamp& rightVector);
+		void mnaApplyRightSideVectorStampHarm(RightVectorStamp& rightVector);
 		void mnaApplyRightSideVectorStampHarm(Matrix& sourceVector, Int freqIdx);
 
 		class MnaPreStep : public CPS::Task {
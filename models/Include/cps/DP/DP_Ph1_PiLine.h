@@ -41,7 +41,7 @@ namespace Ph1 {
 		/// Parallel capacitor submodel at Terminal 1
 		std::shared_ptr<Capacitor> mSubParallelCapacitor1;
 		/// Right side vectors of subcomponents
-		std::vector<const Matrix*> mRightVectorStamps;
+		std::vector<const RightVectorStamp*> mRightVectorStamps;
 	public:
 		/// Defines UID, name and logging level
 		PiLine(String uid, String name, Logger::Level logLevel = Logger::Level::off);
@@ -59,9 +59,9 @@ namespace Ph1 {
 		/// Initializes internal variables of the component
 		void mnaInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector);
 		/// Stamps system matrix
-		void mnaApplySystemMatrixStamp(Matrix& systemMatrix);
+		void mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix);
 		/// Stamps right side (source) vector
-		void mnaApplyRightSideVectorStamp(Matrix& rightVector);
+		void mnaApplyRightSideVectorStamp(RightVectorStamp& rightVector);
 		/// Updates internal current variable of the component
 		void mnaUpdateCurrent(const Matrix& leftVector);
 		/// Updates internal voltage variable of the component
@@ -50,7 +50,7 @@ namespace Ph1 {
 		/// Internal resistance
 		std::shared_ptr<DP::Ph1::Resistor> mSubResistor;
 		/// Right side vectors of subcomponents
-		std::vector<const Matrix*> mRightVectorStamps;
+		std::vector<const RightVectorStamp*> mRightVectorStamps;
 	public:
 		/// Defines UID, name and logging level
 		RXLoad(String uid, String name,
@@ -71,9 +71,9 @@ namespace Ph1 {
 		/// Initializes internal variables of the component
 		void mnaInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector);
 		/// Stamps system matrix
-		void mnaApplySystemMatrixStamp(Matrix& systemMatrix);
+		void mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix);
 		/// Stamps right side (source) vector
-		void mnaApplyRightSideVectorStamp(Matrix& rightVector);
+		void mnaApplyRightSideVectorStamp(RightVectorStamp& rightVector);
 		/// Update interface current from MNA system result
 		void mnaUpdateCurrent(const Matrix& leftVector);
 		/// Update interface voltage from MNA system result
@@ -27,7 +27,7 @@ namespace Ph1 {
 		/// internal switch is only opened after this time offset
 		Real mSwitchTimeOffset = 1.0;
 		/// Right side vectors of subcomponents
-		std::vector<const Matrix*> mRightVectorStamps;
+		std::vector<const RightVectorStamp*> mRightVectorStamps;
 
 	public:
 		/// Defines UID, name and logging level
@@ -50,9 +50,9 @@ namespace Ph1 {
 		/// Initializes internal variables of the component
 		void mnaInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector);
 		/// Stamps system matrix
-		void mnaApplySystemMatrixStamp(Matrix& systemMatrix);
+		void mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix);
 		/// Stamps right side (source) vector
-		void mnaApplyRightSideVectorStamp(Matrix& rightVector);
+		void mnaApplyRightSideVectorStamp(RightVectorStamp& rightVector);
 		/// Update interface current from MNA system result
 		void mnaUpdateCurrent(const Matrix& leftVector) { }
 		/// Update interface voltage from MNA system result
@@ -73,7 +73,7 @@ namespace Ph1 {
 		/// Check if switch is closed
 		Bool mnaIsClosed() { return mSubSwitch->isClosed(); }
 		/// Stamps system matrix considering the defined switch position
-		void mnaApplySwitchSystemMatrixStamp(Matrix& systemMatrix, Bool closed);
+		void mnaApplySwitchSystemMatrixStamp(SparseMatrixRow& systemMatrix, Bool closed);
 
 		class MnaPreStep : public Task {
 		public:
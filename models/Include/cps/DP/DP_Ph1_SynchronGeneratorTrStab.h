@@ -43,6 +43,8 @@ namespace Ph1 {
 		std::shared_ptr<VoltageSource> mSubVoltageSource;
 		/// Inner inductor that represents the generator impedance
 		std::shared_ptr<Inductor> mSubInductor;
+		/// Right side vectors of subcomponents
+		std::vector<const RightVectorStamp*> mRightVectorStamps;
 		// Logging
 		Matrix mStates;
 	public:
@@ -77,9 +79,9 @@ namespace Ph1 {
 		/// to calculate the flux and current from the voltage vector.
 		void mnaStep(Matrix& systemMatrix, Matrix& rightVector, Matrix& leftVector, Real time);
 		///
-		void mnaApplyRightSideVectorStamp(Matrix& rightVector);
+		void mnaApplyRightSideVectorStamp(RightVectorStamp& rightVector);
 		///
-		void mnaApplySystemMatrixStamp(Matrix& systemMatrix);
+		void mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix);
 		/// Retrieves calculated voltage from simulation for next step
 		void mnaPostStep(Matrix& rightVector, Matrix& leftVector, Real time);
 		///
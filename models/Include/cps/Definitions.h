@@ -80,6 +80,8 @@ namespace CPS {
 	///
 	typedef Eigen::SparseLU<SparseMatrix> LUFactorizedSparse;
 	///
+	typedef Eigen::SparseLU<SparseMatrixComp> LUFactorizedSparseComp;
+	///
 	typedef Eigen::Matrix<Real, Eigen::Dynamic, 1> Vector;
 	///
 	template<typename VarType>
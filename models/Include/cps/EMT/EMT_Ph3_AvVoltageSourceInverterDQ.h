@@ -85,7 +85,7 @@ namespace Ph3 {
 		
 		// #### solver ####
 		///
-		std::vector<const Matrix*> mRightVectorStamps;
+		std::vector<const RightVectorStamp*> mRightVectorStamps;
 
 	public:
 		/// Defines name amd logging level
@@ -124,9 +124,9 @@ namespace Ph3 {
 		/// Initializes internal variables of the component
 		void mnaInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector);
 		/// Stamps system matrix
-		void mnaApplySystemMatrixStamp(Matrix& systemMatrix);
+		void mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix);
 		/// Stamps right side (source) vector
-		void mnaApplyRightSideVectorStamp(Matrix& rightVector);
+		void mnaApplyRightSideVectorStamp(RightVectorStamp& rightVector);
 		/// Updates current through the component
 		void mnaUpdateCurrent(const Matrix& leftVector);
 		/// Updates voltage across component
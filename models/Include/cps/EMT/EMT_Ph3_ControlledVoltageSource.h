@@ -29,7 +29,7 @@ namespace CPS {
 
 				// #### solver ####
 				/// Vector to collect subcomponent right vector stamps
-				std::vector<const Matrix*> mRightVectorStamps;
+				std::vector<const RightVectorStamp*> mRightVectorStamps;
 			public:
 				/// Defines UID, name and logging level
 				ControlledVoltageSource(String uid, String name, Logger::Level logLevel = Logger::Level::off);
@@ -49,9 +49,9 @@ namespace CPS {
 				/// Initializes internal variables of the component
 				void mnaInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector);
 				/// Stamps system matrix
-				void mnaApplySystemMatrixStamp(Matrix& systemMatrix);
+				void mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix);
 				/// Stamps right side (source) vector
-				void mnaApplyRightSideVectorStamp(Matrix& rightVector);
+				void mnaApplyRightSideVectorStamp(RightVectorStamp& rightVector);
 				/// Returns current through the component
 				void mnaUpdateCurrent(const Matrix& leftVector);
 				/// Updates voltage across component
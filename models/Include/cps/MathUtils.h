@@ -9,6 +9,7 @@
 #pragma once
 
 #include <cps/Definitions.h>
+#include <cps/Solver/RightVectorStamp.h>
 
 namespace CPS {
 
@@ -116,6 +117,32 @@ namespace CPS {
 			return mat(row, 0);
 		}
 
+		static void setVectorElement(RightVectorStamp& stamp, Matrix::Index row, Complex value, Int maxFreq = 1, Int freqIdx = 0, Matrix::Index colOffset = 0) {
+			Eigen::Index harmonicOffset = stamp.rows() / maxFreq;
+			Eigen::Index complexOffset = harmonicOffset / 2;
+			Eigen::Index harmRow = row + harmonicOffset * freqIdx;
+
+			stamp.coeffRef(harmRow, colOffset) = value.real();
+			stamp.coeffRef(harmRow + complexOffset, colOffset) = value.imag();
+		}
+
+		static void addToVectorElement(RightVectorStamp& stamp, Matrix::Index row, Complex value, Int maxFreq = 1, Int freqIdx = 0) {
+			Eigen::Index harmonicOffset = stamp.rows() / maxFreq;
+			Eigen::Index complexOffset = harmonicOffset / 2;
+			Eigen::Index harmRow = row + harmonicOffset * freqIdx;
+
+			stamp.coeffRef(harmRow) += value.real();
+			stamp.coeffRef(harmRow + complexOffset) += value.imag();
+		}
+
+		static void addToVectorElement(RightVectorStamp& stamp, Matrix::Index row, Real value) {
+			stamp.coeffRef(row) += value;
+		}
+
+		static void setVectorElement(RightVectorStamp& stamp, Matrix::Index row, Real value) {
+			stamp.coeffRef(row) = value;
+		}
+
 		// #### Matric Operations ####
 		//
 		// | Re-Re(row,col)_harm1 | Im-Re(row,col)_harm1 | Interharmonics harm1-harm2
@@ -167,6 +194,57 @@ namespace CPS {
 					addToMatrixElement(mat, rows[phase], columns[phase], value);
 		}
 
+		// #### Sparse Matrix Operations ####
+		//
+		// Same layout as for dense matrices. Only the touched entries are
+		// inserted, so that stamping scales with the number of non-zeros.
+		// Entries are inserted even if the value is zero, so that the sparsity
+		// pattern only depends on the topology and not on parameter values.
+
+		static void setMatrixElement(SparseMatrixRow& mat, Matrix::Index row, Matrix::Index column, Complex value, Int maxFreq = 1, Int freqIdx = 0) {
+			// Assume square matrix
+			Eigen::Index harmonicOffset = mat.rows() / maxFreq;
+			Eigen::Index complexOffset = harmonicOffset / 2;
+			Eigen::Index harmRow = row + harmonicOffset * freqIdx;
+			Eigen::Index harmCol = column + harmonicOffset * freqIdx;
+
+			mat.coeffRef(harmRow, harmCol) = value.real();
+			mat.coeffRef(harmRow + complexOffset, harmCol + complexOffset) = value.real();
+			mat.coeffRef(harmRow, harmCol + complexOffset) = - value.imag();
+			mat.coeffRef(harmRow + complexOffset, harmCol) = value.imag();
+		}
+
+		static void addToMatrixElement(SparseMatrixRow& mat, Matrix::Index row, Matrix::Index column, Complex value, Int maxFreq = 1, Int freqIdx = 0) {
+			// Assume square matrix
+			Eigen::Index harmonicOffset = mat.rows() / maxFreq;
+			Eigen::Index complexOffset = harmonicOffset / 2;
+			Eigen::Index harmRow = row + harmonicOffset * freqIdx;
+			Eigen::Index harmCol = column + harmonicOffset * freqIdx;
+
+			mat.coeffRef(harmRow, harmCol) += value.real();
+			mat.coeffRef(harmRow + complexOffset, harmCol + complexOffset) += value.real();
+			mat.coeffRef(harmRow, harmCol + complexOffset) -= value.imag();
+			mat.coeffRef(harmRow + complexOffset, harmCol) += value.imag();
+		}
+
+		static void setMatrixElement(SparseMatrixRow& mat, Matrix::Index row, Matrix::Index column, Real value) {
+			mat.coeffRef(row, column) = value;
+		}
+
+		static void addToMatrixElement(SparseMatrixRow& mat, std::vector<UInt> rows, std::vector<UInt> columns, Complex value) {
+			for (UInt phase = 0; phase < rows.size(); phase++)
+					addToMatrixElement(mat, rows[phase], columns[phase], value);
+		}
+
+		static void addToMatrixElement(SparseMatrixRow& mat, Matrix::Index row, Matrix::Index column, Real value) {
+			mat.coeffRef(row, column) += value;
+		}
+
+		static void addToMatrixElement(SparseMatrixRow& mat, std::vector<UInt> rows, std::vector<UInt> columns, Real value) {
+			for (UInt phase = 0; phase < rows.size(); phase++)
+					addToMatrixElement(mat, rows[phase], columns[phase], value);
+		}
+
 		// #### Integration Methods ####
 		static Matrix StateSpaceTrapezoidal(Matrix states, Matrix A, Matrix B, Real dt, Matrix u_new, Matrix u_old);
 		static Matrix StateSpaceTrapezoidal(Matrix states, Matrix A, Matrix B, Matrix C, Real dt, Matrix u_new, Matrix u_old);
@@ -21,6 +21,10 @@ namespace CPS {
 		/// Determine state of the simulation, e.g. to implement
 		/// special behavior for components during initialization
 		Bool mBehaviour = Behaviour::Simulation;
+		/// Number of simulation time steps between two executions of the tasks
+		UInt mRateDivisor = 1;
+		/// Interpolate the outputs between two executions instead of holding them
+		Bool mInterpolateOutputs = false;
 	public:
 		typedef std::shared_ptr<SimSignalComp> Ptr;
 		typedef std::vector<Ptr> List;
@@ -42,6 +46,21 @@ namespace CPS {
 		virtual Task::List getTasks() {
 			return Task::List();
 		}
+		/// Tasks of the component with the rate divisor of the component applied
+		Task::List getTasksAtRate() {
+			auto tasks = getTasks();
+			for (auto& task : tasks)
+				task->setRateDivisor(mRateDivisor, mInterpolateOutputs);
+			return tasks;
+		}
+		/// Execute the tasks of the component only in every divisor-th time
+		/// step. The component is initialized with the correspondingly longer
+		/// time step.
+		void setRateDivisor(UInt divisor, Bool interpolate = false) {
+			mRateDivisor = divisor > 0 ? divisor : 1;
+			mInterpolateOutputs = interpolate;
+		}
+		UInt rateDivisor() const { return mRateDivisor; }
 		/// Set behavior of component, e.g. initialization
 		void setBehaviour(Behaviour behaviour) { mBehaviour = behaviour; }
 	};
@@ -12,6 +12,7 @@
 #include <cps/Config.h>
 #include <cps/Definitions.h>
 #include <cps/Task.h>
+#include <cps/Solver/RightVectorStamp.h>
 
 namespace CPS {
 	/// Interface to be implemented by all models used by the MNA solver.
@@ -28,16 +29,21 @@ namespace CPS {
 		virtual void mnaInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector) {
 			mnaInitialize(omega, timeStep);
 		}
-		/// Stamps system matrix
-		virtual void mnaApplySystemMatrixStamp(Matrix& systemMatrix) { }
-		/// Stamps (sparse) system matrix
-		virtual void mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
-			Matrix mat = Matrix(systemMatrix);
-			mnaApplySystemMatrixStamp(mat);
-			systemMatrix = mat.sparseView();
+		/// Stamps (sparse) system matrix. Components only insert their own
+		/// non-zero entries so that assembly scales with the number of non-zeros.
+		virtual void mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) { }
+		/// Stamps dense system matrix. By default, the sparse stamp of the
+		/// component is added to the matrix, so entries written with
+		/// setMatrixElement are added to existing values instead of replacing them.
+		/// Components stamped via their own type have to import this overload
+		/// with a using declaration, because the sparse override hides it.
+		virtual void mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+			SparseMatrixRow stamp(systemMatrix.rows(), systemMatrix.cols());
+			mnaApplySystemMatrixStamp(stamp);
+			systemMatrix += stamp;
 		}
 		/// Stamps right side (source) vector
-		virtual void mnaApplyRightSideVectorStamp(Matrix& rightVector) { }
+		virtual void mnaApplyRightSideVectorStamp(RightVectorStamp& rightVector) { }
 		/// Update interface voltage from MNA system result
 		virtual void mnaUpdateVoltage(const Matrix& leftVector) { }
 		/// Update interface current from MNA system result
@@ -59,7 +65,7 @@ namespace CPS {
 		/// Stamps system matrix considering the frequency index
 		virtual void mnaApplySystemMatrixStampHarm(Matrix& systemMatrix, Int freqIdx) { }
 		/// Stamps right side (source) vector considering the frequency index
-		virtual void mnaApplyRightSideVectorStampHarm(Matrix& sourceVector) { }
+		virtual void mnaApplyRightSideVectorStampHarm(RightVectorStamp& sourceVector) { }
 		virtual void mnaApplyRightSideVectorStampHarm(Matrix& sourceVector, Int freqIdx) { }
 		/// Return list of MNA tasks
 		const Task::List& mnaTasks() {
@@ -68,13 +74,13 @@ namespace CPS {
 	protected:
 		/// Every MNA component modifies its source vector attribute.
 		MNAInterface() {
-			addAttribute<Matrix>("right_vector", &mRightVector, Flags::read);
+			addAttribute<RightVectorStamp>("right_vector", &mRightVector, Flags::read);
 		}
 
 		/// List of tasks that relate to using MNA for this component (usually pre-step and/or post-step)
 		Task::List mMnaTasks;
-		/// This component's contribution ("stamp") to the right-side vector.
-		/// TODO performance improvements from a sparse representation, at least during copying / summation?
-		Matrix mRightVector;
+		/// This component's contribution ("stamp") to the right-side vector,
+		/// which the MNA solver scatter-adds to its source vector.
+		RightVectorStamp mRightVector;
 	};
 }
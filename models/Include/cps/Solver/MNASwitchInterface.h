@@ -22,13 +22,14 @@ namespace CPS {
 		// #### MNA section ####
 		/// Check if switch is closed
 		virtual Bool mnaIsClosed() = 0;
-		/// Stamps system matrix considering the defined switch position
-		virtual void mnaApplySwitchSystemMatrixStamp(Matrix& systemMatrix, Bool closed) { }
 		/// Stamps (sparse) system matrix considering the defined switch position
-		virtual void mnaApplySwitchSystemMatrixStamp(SparseMatrixRow& systemMatrix, Bool closed) {
-			Matrix mat = Matrix(systemMatrix);
-			mnaApplySwitchSystemMatrixStamp(mat, closed);
-			systemMatrix = mat.sparseView();
+		virtual void mnaApplySwitchSystemMatrixStamp(SparseMatrixRow& systemMatrix, Bool closed) { }
+		/// Stamps dense system matrix considering the defined switch position.
+		/// The sparse stamp is added to the matrix, see MNAInterface.
+		virtual void mnaApplySwitchSystemMatrixStamp(Matrix& systemMatrix, Bool closed) {
+			SparseMatrixRow stamp(systemMatrix.rows(), systemMatrix.cols());
+			mnaApplySwitchSystemMatrixStamp(stamp, closed);
+			systemMatrix += stamp;
 		}
 	};
 }
@@ -0,0 +1,87 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <vector>
+
+#include <cps/Definitions.h>
+
+namespace CPS {
+	/// Contribution ("stamp") of a component to the right side vector of the
+	/// MNA system. Only the entries written by the component are stored as
+	/// (row, column, value), so the memory does not grow with the system.
+	/// An entry is created by its first write and overwritten afterwards,
+	/// which is why the stamp is not reset between steps.
+	class RightVectorStamp {
+	public:
+		struct Entry {
+			Matrix::Index row;
+			Matrix::Index col;
+			Real value;
+		};
+
+		RightVectorStamp() { }
+		/// Creates a stamp for a system vector with the given dimensions.
+		/// The dimensions determine the offsets of imaginary parts and
+		/// harmonics as for the dense vector.
+		RightVectorStamp(Matrix::Index rows, Matrix::Index cols = 1) :
+			mRows(rows), mCols(cols) { }
+
+		Matrix::Index rows() const { return mRows; }
+		Matrix::Index cols() const { return mCols; }
+		/// Size of the system vector, zero if the component has no stamp
+		Matrix::Index size() const { return mRows * mCols; }
+		const std::vector<Entry>& entries() const { return mEntries; }
+
+		/// Returns the value of an entry, which is created on first access
+		Real& coeffRef(Matrix::Index row, Matrix::Index col = 0) {
+			for (auto& entry : mEntries) {
+				if (entry.row == row && entry.col == col)
+					return entry.value;
+			}
+			mEntries.push_back({ row, col, 0 });
+			return mEntries.back().value;
+		}
+
+		/// Sets the entries to the sum of the given stamps
+		void setSum(const std::vector<const RightVectorStamp*>& stamps) {
+			for (auto& entry : mEntries)
+				entry.value = 0;
+			for (auto stamp : stamps) {
+				for (auto& entry : stamp->mEntries)
+					coeffRef(entry.row, entry.col) += entry.value;
+			}
+		}
+
+		/// Scatter-adds the entries to a dense vector, shifted by rowOffset
+		/// if the system vector is a block of the given vector
+		void addTo(Matrix& vector, Matrix::Index rowOffset = 0) const {
+			for (auto& entry : mEntries)
+				vector(entry.row + rowOffset, entry.col) += entry.value;
+		}
+		/// Scatter-adds the entries of one column (frequency) to a vector
+		void addColumnTo(Matrix& vector, Matrix::Index col) const {
+			for (auto& entry : mEntries) {
+				if (entry.col == col)
+					vector(entry.row, 0) += entry.value;
+			}
+		}
+		/// Returns the stamp as dense vector
+		Matrix toDense() const {
+			Matrix vector = Matrix::Zero(mRows, mCols);
+			addTo(vector);
+			return vector;
+		}
+
+	private:
+		Matrix::Index mRows = 0;
+		Matrix::Index mCols = 0;
+		std::vector<Entry> mEntries;
+	};
+}
@@ -48,9 +48,23 @@ namespace CPS {
 			return mPrevStepDependencies;
 		}
 
+		/// Execute the task only in every divisor-th time step. In between,
+		/// the modified attributes hold their values or, if interpolate is set,
+		/// are interpolated linearly between the last two results.
+		void setRateDivisor(UInt divisor, Bool interpolate = false) {
+			mRateDivisor = divisor > 0 ? divisor : 1;
+			mInterpolateOutputs = interpolate;
+		}
+		UInt rateDivisor() const { return mRateDivisor; }
+		Bool interpolateOutputs() const { return mInterpolateOutputs; }
+
 	protected:
 		Task(std::string name) : mName(name) {}
 		std::string mName;
+		/// Number of time steps between two executions of the task
+		UInt mRateDivisor = 1;
+		/// Interpolate the modified attributes between two executions
+		Bool mInterpolateOutputs = false;
 		std::vector<AttributeBase::Ptr> mAttributeDependencies;
 		std::vector<AttributeBase::Ptr> mModifiedAttributes;
 		std::vector<AttributeBase::Ptr> mPrevStepDependencies;
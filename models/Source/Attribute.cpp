@@ -34,6 +34,14 @@ String Attribute<Matrix>::toString() const {
 	return ss.str();
 }
 
+template<>
+String Attribute<RightVectorStamp>::toString() const {
+	std::stringstream ss;
+	ss.precision(2);
+	ss << mValue->toDense();
+	return ss.str();
+}
+
 template<>
 String Attribute<Complex>::toString() const {
 	std::stringstream ss;
@@ -55,11 +63,37 @@ void Attribute<Matrix>::fromPyObject(PyObject *po) {
 	throw std::runtime_error("not implemented"); // TODO
 }
 
+/// Converts a real matrix to a list of rows
+static PyObject * matrixToPyList(const Matrix &m) {
+	PyObject *rows = PyList_New(m.rows());
+
+	for (Matrix::Index i = 0; i < m.rows(); i++) {
+		PyObject *row = PyList_New(m.cols());
+
+		for (Matrix::Index j = 0; j < m.cols(); j++)
+			PyList_SET_ITEM(row, j, PyFloat_FromDouble(m(i, j)));
+
+		PyList_SET_ITEM(rows, i, row);
+	}
+
+	return rows;
+}
+
 template<>
 PyObject * Attribute<Matrix>::toPyObject() {
-	throw std::runtime_error("not implemented"); // TODO
+	return matrixToPyList(get());
+}
 
-	return nullptr;
+// RightVectorStamp
+template<>
+void Attribute<RightVectorStamp>::fromPyObject(PyObject *po) {
+	// Stamps are only written by their component
+	throw AccessException();
+}
+
+template<>
+PyObject * Attribute<RightVectorStamp>::toPyObject() {
+	return matrixToPyList(get().toDense());
 }
 
 // MatrixComp
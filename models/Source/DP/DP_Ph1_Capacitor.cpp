@@ -76,7 +76,7 @@ void DP::Ph1::Capacitor::mnaInitialize(Real omega, Real timeStep, Attribute<Matr
 		mIntfCurrent(0, freq) = mEquivCond(freq,0) * mIntfVoltage(0,freq) + mEquivCurrent(freq,0);
 	}
 
-	mRightVector = Matrix::Zero(leftVector->get().rows(), 1);
+	mRightVector = RightVectorStamp(leftVector->get().rows(), 1);
 	mMnaTasks.push_back(std::make_shared<MnaPreStep>(*this));
 	mMnaTasks.push_back(std::make_shared<MnaPostStep>(*this, leftVector));
 
@@ -110,10 +110,10 @@ void DP::Ph1::Capacitor::mnaInitializeHarm(Real omega, Real timeStep, std::vecto
 
 	mMnaTasks.push_back(std::make_shared<MnaPreStepHarm>(*this));
 	mMnaTasks.push_back(std::make_shared<MnaPostStepHarm>(*this, leftVectors));
-	mRightVector = Matrix::Zero(leftVectors[0]->get().rows(), mNumFreqs);
+	mRightVector = RightVectorStamp(leftVectors[0]->get().rows(), mNumFreqs);
 }
 
-void DP::Ph1::Capacitor::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void DP::Ph1::Capacitor::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 	for (UInt freq = 0; freq < mNumFreqs; freq++) {
 		if (terminalNotGrounded(0))
 			Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0), matrixNodeIndex(0), mEquivCond(freq,0), mNumFreqs, freq);
@@ -165,7 +165,7 @@ void DP::Ph1::Capacitor::mnaApplySystemMatrixStampHarm(Matrix& systemMatrix, Int
 	}
 }
 
-void DP::Ph1::Capacitor::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
+void DP::Ph1::Capacitor::mnaApplyRightSideVectorStamp(RightVectorStamp& rightVector) {
 	for (UInt freq = 0; freq < mNumFreqs; freq++) {
 		//mCureqr = mCurrr + mGcr * mDeltavr + mGci * mDeltavi;
 		//mCureqi = mCurri + mGcr * mDeltavi - mGci * mDeltavr;
@@ -188,7 +188,7 @@ void DP::Ph1::Capacitor::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
 	}
 }
 
-void DP::Ph1::Capacitor::mnaApplyRightSideVectorStampHarm(Matrix& rightVector) {
+void DP::Ph1::Capacitor::mnaApplyRightSideVectorStampHarm(RightVectorStamp& rightVector) {
 	for (UInt freq = 0; freq < mNumFreqs; freq++) {
 		//mCureqr = mCurrr + mGcr * mDeltavr + mGci * mDeltavi;
 		//mCureqi = mCurri + mGcr * mDeltavi - mGci * mDeltavr;
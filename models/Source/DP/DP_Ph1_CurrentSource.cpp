@@ -62,14 +62,14 @@ void DP::Ph1::CurrentSource::mnaInitialize(Real omega, Real timeStep, Attribute<
 	mIntfCurrent(0,0) = mCurrentRef->get();
 	mMnaTasks.push_back(std::make_shared<MnaPreStep>(*this));
 	mMnaTasks.push_back(std::make_shared<MnaPostStep>(*this, leftVector));
-	mRightVector = Matrix::Zero(leftVector->get().rows(), 1);
+	mRightVector = RightVectorStamp(leftVector->get().rows(), 1);
 }
 
 void DP::Ph1::CurrentSource::MnaPreStep::execute(Real time, Int timeStepCount) {
 	mCurrentSource.mnaApplyRightSideVectorStamp(mCurrentSource.mRightVector);
 }
 
-void DP::Ph1::CurrentSource::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
+void DP::Ph1::CurrentSource::mnaApplyRightSideVectorStamp(RightVectorStamp& rightVector) {
 	mIntfCurrent(0,0) = mCurrentRef->get();
 
 	if (terminalNotGrounded(0))
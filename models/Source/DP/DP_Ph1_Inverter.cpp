@@ -114,7 +114,7 @@ void DP::Ph1::Inverter::mnaInitialize(Real omega, Real timeStep, Attribute<Matri
 
 	mMnaTasks.push_back(std::make_shared<MnaPreStep>(*this));
 	mMnaTasks.push_back(std::make_shared<MnaPostStep>(*this, leftVector));
-	mRightVector = Matrix::Zero(leftVector->get().rows(), 1);
+	mRightVector = RightVectorStamp(leftVector->get().rows(), 1);
 
 	calculatePhasors();
 }
@@ -125,12 +125,12 @@ void DP::Ph1::Inverter::mnaInitializeHarm(Real omega, Real timeStep, std::vector
 
 	mMnaTasks.push_back(std::make_shared<MnaPreStepHarm>(*this));
 	mMnaTasks.push_back(std::make_shared<MnaPostStepHarm>(*this, leftVectors));
-	mRightVector = Matrix::Zero(leftVectors[0]->get().rows(), mNumFreqs);
+	mRightVector = RightVectorStamp(leftVectors[0]->get().rows(), mNumFreqs);
 
 	calculatePhasors();
 }
 
-void DP::Ph1::Inverter::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void DP::Ph1::Inverter::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 	mSLog->info("--- Stamping into system matrix ---");
 
 	for (UInt freq = 0; freq < mNumFreqs; freq++) {
@@ -161,7 +161,7 @@ void DP::Ph1::Inverter::mnaApplySystemMatrixStampHarm(Matrix& systemMatrix, Int
 	}
 }
 
-void DP::Ph1::Inverter::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
+void DP::Ph1::Inverter::mnaApplyRightSideVectorStamp(RightVectorStamp& rightVector) {
 	SPDLOG_LOGGER_DEBUG(mSLog, "Stamp harmonics into source vector");
 	for (UInt freq = 0; freq < mNumFreqs; freq++) {
 		if (terminalNotGrounded(0)) {
@@ -173,7 +173,7 @@ void DP::Ph1::Inverter::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
 	}
 }
 
-void DP::Ph1::Inverter::mnaApplyRightSideVectorStampHarm(Matrix& rightVector) {
+void DP::Ph1::Inverter::mnaApplyRightSideVectorStampHarm(RightVectorStamp& rightVector) {
 	SPDLOG_LOGGER_DEBUG(mSLog, "Stamp harmonics into source vector");
 	for (UInt freq = 0; freq < mNumFreqs; freq++) {
 		if (terminalNotGrounded(0)) {
@@ -107,11 +107,11 @@ void DP::Ph1::PQLoadCS::mnaInitialize(Real omega, Real timeStep, Attribute<Matri
 		mMnaTasks.push_back(task);
 }
 
-void DP::Ph1::PQLoadCS::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
+void DP::Ph1::PQLoadCS::mnaApplyRightSideVectorStamp(RightVectorStamp& rightVector) {
 	mSubCurrentSource->mnaApplyRightSideVectorStamp(rightVector);
 }
 
-void DP::Ph1::PQLoadCS::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void DP::Ph1::PQLoadCS::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 	mSubCurrentSource->mnaApplySystemMatrixStamp(systemMatrix);
 }
 
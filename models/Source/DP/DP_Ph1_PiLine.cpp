@@ -110,7 +110,7 @@ void DP::Ph1::PiLine::mnaInitialize(Real omega, Real timeStep, Attribute<Matrix>
 
 	mSubSeriesResistor->mnaInitialize(omega, timeStep, leftVector);
 	mSubSeriesInductor->mnaInitialize(omega, timeStep, leftVector);
-	mRightVectorStamps.push_back(&mSubSeriesInductor->attribute<Matrix>("right_vector")->get());
+	mRightVectorStamps.push_back(&mSubSeriesInductor->attribute<RightVectorStamp>("right_vector")->get());
 
 	mSubParallelResistor0->mnaInitialize(omega, timeStep, leftVector);
 	mSubParallelResistor1->mnaInitialize(omega, timeStep, leftVector);
@@ -120,17 +120,17 @@ void DP::Ph1::PiLine::mnaInitialize(Real omega, Real timeStep, Attribute<Matrix>
 	if (mParallelCap >= 0) {
 		mSubParallelCapacitor0->mnaInitialize(omega, timeStep, leftVector);
 		mSubParallelCapacitor1->mnaInitialize(omega, timeStep, leftVector);
-		mRightVectorStamps.push_back(&mSubParallelCapacitor0->attribute<Matrix>("right_vector")->get());
-		mRightVectorStamps.push_back(&mSubParallelCapacitor1->attribute<Matrix>("right_vector")->get());
+		mRightVectorStamps.push_back(&mSubParallelCapacitor0->attribute<RightVectorStamp>("right_vector")->get());
+		mRightVectorStamps.push_back(&mSubParallelCapacitor1->attribute<RightVectorStamp>("right_vector")->get());
 		subComps.push_back(mSubParallelCapacitor0);
 		subComps.push_back(mSubParallelCapacitor1);
 	}
 	mMnaTasks.push_back(std::make_shared<MnaPreStep>(*this));
 	mMnaTasks.push_back(std::make_shared<MnaPostStep>(*this, leftVector));
-	mRightVector = Matrix::Zero(leftVector->get().rows(), 1);
+	mRightVector = RightVectorStamp(leftVector->get().rows(), 1);
 }
 
-void DP::Ph1::PiLine::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void DP::Ph1::PiLine::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 	mSubSeriesResistor->mnaApplySystemMatrixStamp(systemMatrix);
 	mSubSeriesInductor->mnaApplySystemMatrixStamp(systemMatrix);
 
@@ -143,10 +143,8 @@ void DP::Ph1::PiLine::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
 	}
 }
 
-void DP::Ph1::PiLine::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
-	rightVector.setZero();
-	for (auto stamp : mRightVectorStamps)
-		rightVector += *stamp;
+void DP::Ph1::PiLine::mnaApplyRightSideVectorStamp(RightVectorStamp& rightVector) {
+	rightVector.setSum(mRightVectorStamps);
 }
 
 void DP::Ph1::PiLine::mnaAddPreStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes) {
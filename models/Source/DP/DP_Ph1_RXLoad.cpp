@@ -115,19 +115,19 @@ void DP::Ph1::RXLoad::mnaInitialize(Real omega, Real timeStep, Attribute<Matrix>
 	}
 	if (mSubInductor) {
 		mSubInductor->mnaInitialize(omega, timeStep, leftVector);
-		mRightVectorStamps.push_back(&mSubInductor->attribute<Matrix>("right_vector")->get());
+		mRightVectorStamps.push_back(&mSubInductor->attribute<RightVectorStamp>("right_vector")->get());
 	}
 	if (mSubCapacitor) {
 		mSubCapacitor->mnaInitialize(omega, timeStep, leftVector);
-		mRightVectorStamps.push_back(&mSubInductor->attribute<Matrix>("right_vector")->get());
+		mRightVectorStamps.push_back(&mSubInductor->attribute<RightVectorStamp>("right_vector")->get());
 	}
 
 	mMnaTasks.push_back(std::make_shared<MnaPreStep>(*this));
 	mMnaTasks.push_back(std::make_shared<MnaPostStep>(*this, leftVector));
-	mRightVector = Matrix::Zero(leftVector->get().rows(), 1);
+	mRightVector = RightVectorStamp(leftVector->get().rows(), 1);
 }
 
-void DP::Ph1::RXLoad::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
+void DP::Ph1::RXLoad::mnaApplyRightSideVectorStamp(RightVectorStamp& rightVector) {
 	if (mSubResistor)
 		mSubResistor->mnaApplyRightSideVectorStamp(rightVector);
 	if (mSubInductor)
@@ -136,7 +136,7 @@ void DP::Ph1::RXLoad::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
 		mSubCapacitor->mnaApplyRightSideVectorStamp(rightVector);
 }
 
-void DP::Ph1::RXLoad::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void DP::Ph1::RXLoad::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 	if (mSubResistor)
 		mSubResistor->mnaApplySystemMatrixStamp(systemMatrix);
 	if (mSubInductor)
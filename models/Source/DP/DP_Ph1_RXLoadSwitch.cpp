@@ -79,25 +79,23 @@ void DP::Ph1::RXLoadSwitch::mnaInitialize(Real omega, Real timeStep, Attribute<M
 	mSubRXLoad->mnaInitialize(omega, timeStep, leftVector);
 	mSubSwitch->mnaInitialize(omega, timeStep, leftVector);
 	// get sub component right vector
-	mRightVectorStamps.push_back(&mSubRXLoad->attribute<Matrix>("right_vector")->get());
+	mRightVectorStamps.push_back(&mSubRXLoad->attribute<RightVectorStamp>("right_vector")->get());
 
-	mRightVector = Matrix::Zero(leftVector->get().rows(), 1);
+	mRightVector = RightVectorStamp(leftVector->get().rows(), 1);
 	mMnaTasks.push_back(std::make_shared<MnaPreStep>(*this));
 	mMnaTasks.push_back(std::make_shared<MnaPostStep>(*this, leftVector));
 }
 
-void DP::Ph1::RXLoadSwitch::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
-	rightVector.setZero();
-	for (auto stamp : mRightVectorStamps)
-		rightVector += *stamp;
+void DP::Ph1::RXLoadSwitch::mnaApplyRightSideVectorStamp(RightVectorStamp& rightVector) {
+	rightVector.setSum(mRightVectorStamps);
 }
 
-void DP::Ph1::RXLoadSwitch::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void DP::Ph1::RXLoadSwitch::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 	mSubRXLoad->mnaApplySystemMatrixStamp(systemMatrix);
 	mSubSwitch->mnaApplySystemMatrixStamp(systemMatrix);
 }
 
-void DP::Ph1::RXLoadSwitch::mnaApplySwitchSystemMatrixStamp(Matrix& systemMatrix, Bool closed) {
+void DP::Ph1::RXLoadSwitch::mnaApplySwitchSystemMatrixStamp(SparseMatrixRow& systemMatrix, Bool closed) {
 	mSubRXLoad->mnaApplySystemMatrixStamp(systemMatrix);
 	mSubSwitch->mnaApplySwitchSystemMatrixStamp(systemMatrix, closed);
 }
@@ -116,30 +116,30 @@ void DP::Ph1::SVC::mnaInitialize(Real omega, Real timeStep, Attribute<Matrix>::P
 		mTerminals[0]->node()->name(), mTerminals[0]->node()->matrixNodeIndex());
 
     mSubInductor->mnaInitialize(omega, timeStep, leftVector);
-    mRightVectorStamps.push_back(&mSubInductor->attribute<Matrix>("right_vector")->get());
+    mRightVectorStamps.push_back(&mSubInductor->attribute<RightVectorStamp>("right_vector")->get());
 
     mSubInductorSwitch->mnaInitialize(omega, timeStep, leftVector);
-    mRighteVctorStamps.push_back(&mSubInductorSwitch->attribute<Matrix>("right_vector")->get());
+    mRighteVctorStamps.push_back(&mSubInductorSwitch->attribute<RightVectorStamp>("right_vector")->get());
 
     mSubCapacitor->mnaInitialize(omega, timeStep, leftVector);
-    mRightVectorStamps.push_back(&mSubCapacitor->attribute<Matrix>("right_vector")->get());
+    mRightVectorStamps.push_back(&mSubCapacitor->attribute<RightVectorStamp>("right_vector")->get());
 
     mSubCapacitorSwitch->mnaInitialize(omega, timeStep, leftVector);
-    mRightVectorStamps.push_back(&mSubCapacitorSwitch->attribute<Matrix>("right_vector")->get());
+    mRightVectorStamps.push_back(&mSubCapacitorSwitch->attribute<RightVectorStamp>("right_vector")->get());
 
 	mMnaTasks.push_back(std::make_shared<MnaPreStep>(*this));
 	mMnaTasks.push_back(std::make_shared<MnaPostStep>(*this, leftVector));
-	mRightVector = Matrix::Zero(leftVector->get().rows(), 1);
+	mRightVector = RightVectorStamp(leftVector->get().rows(), 1);
 }
 
-void DP::Ph1::SVC::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void DP::Ph1::SVC::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 	mSubInductor->mnaApplySystemMatrixStamp(systemMatrix);
 	mSubCapacitor->mnaApplySystemMatrixStamp(systemMatrix);
 	mSubCapacitorSwitch->mnaApplySystemMatrixStamp(systemMatrix);
 	mSubInductorSwitch->mnaApplySystemMatrixStamp(systemMatrix);
 }
 
-void DP::Ph1::SVC::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
+void DP::Ph1::SVC::mnaApplyRightSideVectorStamp(RightVectorStamp& rightVector) {
 	mSubInductor->mnaApplyRightSideVectorStamp(rightVector);
 	mSubCapacitor->mnaApplyRightSideVectorStamp(rightVector);
 	mSubCapacitorSwitch->mnaApplyRightSideVectorStamp(rightVector);
@@ -64,11 +64,11 @@ void DP::Ph1::SynchronGeneratorIdeal::mnaInitialize(Real omega, Real timeStep, A
 	}
 }
 
-void DP::Ph1::SynchronGeneratorIdeal::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void DP::Ph1::SynchronGeneratorIdeal::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 	mSubVoltageSource->mnaApplySystemMatrixStamp(systemMatrix);
 }
 
-void DP::Ph1::SynchronGeneratorIdeal::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
+void DP::Ph1::SynchronGeneratorIdeal::mnaApplyRightSideVectorStamp(RightVectorStamp& rightVector) {
 	mSubVoltageSource->mnaApplyRightSideVectorStamp(rightVector);
 }
 
@@ -188,7 +188,9 @@ void DP::Ph1::SynchronGeneratorTrStab::mnaInitialize(Real omega, Real timeStep,
 	mSubVoltageSource->mnaInitialize(omega, timeStep, leftVector);
 	mSubInductor->mnaInitialize(omega, timeStep, leftVector);
 	mTimeStep = timeStep;
-	mRightVector = Matrix::Zero(leftVector->get().rows(), 1);
+	mRightVector = RightVectorStamp(leftVector->get().rows(), 1);
+	mRightVectorStamps.push_back(&mSubVoltageSource->attribute<RightVectorStamp>("right_vector")->get());
+	mRightVectorStamps.push_back(&mSubInductor->attribute<RightVectorStamp>("right_vector")->get());
 	for (auto task : mSubVoltageSource->mnaTasks()) {
 		mMnaTasks.push_back(task);
 	}
@@ -200,12 +202,12 @@ void DP::Ph1::SynchronGeneratorTrStab::mnaInitialize(Real omega, Real timeStep,
 	mMnaTasks.push_back(std::make_shared<MnaPostStep>(*this, leftVector));
 }
 
-void DP::Ph1::SynchronGeneratorTrStab::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void DP::Ph1::SynchronGeneratorTrStab::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 	mSubVoltageSource->mnaApplySystemMatrixStamp(systemMatrix);
 	mSubInductor->mnaApplySystemMatrixStamp(systemMatrix);
 }
 
-void DP::Ph1::SynchronGeneratorTrStab::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
+void DP::Ph1::SynchronGeneratorTrStab::mnaApplyRightSideVectorStamp(RightVectorStamp& rightVector) {
 	mSubVoltageSource->mnaApplyRightSideVectorStamp(rightVector);
 	mSubInductor->mnaApplyRightSideVectorStamp(rightVector);
 }
@@ -216,9 +218,7 @@ void DP::Ph1::SynchronGeneratorTrStab::MnaPreStep::execute(Real time, Int timeSt
 }
 
 void DP::Ph1::SynchronGeneratorTrStab::AddBStep::execute(Real time, Int timeStepCount) {
-	mGenerator.mRightVector =
-		mGenerator.mSubInductor->attribute<Matrix>("right_vector")->get()
-		+ mGenerator.mSubVoltageSource->attribute<Matrix>("right_vector")->get();
+	mGenerator.mRightVector.setSum(mGenerator.mRightVectorStamps);
 }
 
 void DP::Ph1::SynchronGeneratorTrStab::MnaPostStep::execute(Real time, Int timeStepCount) {
@@ -116,7 +116,7 @@ void DP::Ph1::Transformer::mnaInitialize(Real omega, Real timeStep, Attribute<Ma
 	MNAInterface::mnaInitialize(omega, timeStep);
 	updateMatrixNodeIndices();
 
-	mRightVector = Matrix::Zero(leftVector->get().rows(), 1);
+	mRightVector = RightVectorStamp(leftVector->get().rows(), 1);
 	auto subComponents = MNAInterface::List({mSubInductor, mSubSnubResistor});
 
 	if (mSubResistor)
@@ -140,7 +140,7 @@ void DP::Ph1::Transformer::mnaInitialize(Real omega, Real timeStep, Attribute<Ma
 		mTerminals[1]->node()->name(), mTerminals[1]->node()->matrixNodeIndex());
 }
 
-void DP::Ph1::Transformer::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void DP::Ph1::Transformer::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 	// Ideal transformer equations
 	if (terminalNotGrounded(0)) {
 		Math::setMatrixElement(systemMatrix, mVirtualNodes[0]->matrixNodeIndex(), mVirtualNodes[1]->matrixNodeIndex(), Complex(-1.0, 0));
@@ -173,7 +173,7 @@ void DP::Ph1::Transformer::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
 	}
 }
 
-void DP::Ph1::Transformer::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
+void DP::Ph1::Transformer::mnaApplyRightSideVectorStamp(RightVectorStamp& rightVector) {
 	mSubInductor->mnaApplyRightSideVectorStamp(rightVector);
 }
 
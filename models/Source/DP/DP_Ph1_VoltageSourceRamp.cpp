@@ -70,11 +70,11 @@ void DP::Ph1::VoltageSourceRamp::mnaInitialize(Real omega, Real timeStep, Attrib
 	}
 }
 
-void DP::Ph1::VoltageSourceRamp::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void DP::Ph1::VoltageSourceRamp::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 	mSubVoltageSource->mnaApplySystemMatrixStamp(systemMatrix);
 }
 
-void DP::Ph1::VoltageSourceRamp::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
+void DP::Ph1::VoltageSourceRamp::mnaApplyRightSideVectorStamp(RightVectorStamp& rightVector) {
 	mSubVoltageSource->mnaApplyRightSideVectorStamp(rightVector);
 }
 
@@ -127,12 +127,12 @@ void DP::Ph3::Capacitor::mnaInitialize(Real omega, Real timeStep, Attribute<Matr
 	// 			<< "<" << Math::phaseDeg(mIntfCurrent(0,0)) << std::endl
 	// 			<< "--- MNA initialization finished ---" << std::endl;
 
-	mRightVector = Matrix::Zero(leftVector->get().rows(), 1);
+	mRightVector = RightVectorStamp(leftVector->get().rows(), 1);
 	mMnaTasks.push_back(std::make_shared<MnaPreStep>(*this));
 	mMnaTasks.push_back(std::make_shared<MnaPostStep>(*this, leftVector));
 }
 
-void DP::Ph3::Capacitor::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void DP::Ph3::Capacitor::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 
 	if (terminalNotGrounded(0)) {
 		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0, 0), matrixNodeIndex(0, 0), mEquivCond(0, 0));
@@ -198,7 +198,7 @@ void DP::Ph3::Capacitor::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
 	}*/
 }
 
-void DP::Ph3::Capacitor::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
+void DP::Ph3::Capacitor::mnaApplyRightSideVectorStamp(RightVectorStamp& rightVector) {
 	//mCureqr = mCurrr + mGcr * mDeltavr + mGci * mDeltavi;
 	//mCureqi = mCurri + mGcr * mDeltavi - mGci * mDeltavr;
 
@@ -99,10 +99,10 @@ void DP::Ph3::Inductor::mnaInitialize(Real omega, Real timeStep, Attribute<Matri
 
 	mMnaTasks.push_back(std::make_shared<MnaPreStep>(*this));
 	mMnaTasks.push_back(std::make_shared<MnaPostStep>(*this, leftVector));
-	mRightVector = Matrix::Zero(leftVector->get().rows(), 1);
+	mRightVector = RightVectorStamp(leftVector->get().rows(), 1);
 }
 
-void DP::Ph3::Inductor::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void DP::Ph3::Inductor::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 
 	if (terminalNotGrounded(0)) {
 		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0, 0), matrixNodeIndex(0, 0), mEquivCond(0, 0));
@@ -158,7 +158,7 @@ void DP::Ph3::Inductor::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
 	// 				 << "Add " << -mEquivCond << " to system at " << matrixNodeIndex(1) << "," << matrixNodeIndex(0) << std::endl;
 }
 
-void DP::Ph3::Inductor::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
+void DP::Ph3::Inductor::mnaApplyRightSideVectorStamp(RightVectorStamp& rightVector) {
 
 	// Calculate equivalent current source for next time step
 	mEquivCurrent = mEquivCond * mIntfVoltage + mPrevCurrFac * mIntfCurrent;
@@ -25,7 +25,7 @@ void DP::Ph3::SynchronGeneratorDQODE::mnaInitialize(Real omega, Real timeStep, A
 	mDim = mNumDampingWindings + 7;
 	mOdePreState = Matrix::Zero(mDim, 1);
 	mOdePostState = Matrix::Zero(mDim, 1);
-	mRightVector = Matrix::Zero(leftVector->get().rows(), 1);
+	mRightVector = RightVectorStamp(leftVector->get().rows(), 1);
 
 	mMnaTasks.push_back(std::make_shared<MnaPreStep>(*this));
 	mMnaTasks.push_back(std::make_shared<MnaPostStep>(*this, leftVector));
@@ -42,10 +42,10 @@ void EMT::Ph1::CurrentSource::mnaInitialize(Real omega, Real timeStep, Attribute
 	mIntfCurrent(0,0) = Math::abs(mCurrentRef->get()) * cos(Math::phase(mCurrentRef->get()));
 	mMnaTasks.push_back(std::make_shared<MnaPreStep>(*this));
 	mMnaTasks.push_back(std::make_shared<MnaPostStep>(*this, leftVector));
-	mRightVector = Matrix::Zero(leftVector->get().rows(), 1);
+	mRightVector = RightVectorStamp(leftVector->get().rows(), 1);
 }
 
-void EMT::Ph1::CurrentSource::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
+void EMT::Ph1::CurrentSource::mnaApplyRightSideVectorStamp(RightVectorStamp& rightVector) {
 	if (terminalNotGrounded(0))
 		Math::setVectorElement(rightVector, matrixNodeIndex(0), -mIntfCurrent(0,0));
 
@@ -67,11 +67,11 @@ void EMT::Ph1::VoltageSourceRamp::mnaInitialize(Real omega, Real timeStep, Attri
 	}
 }
 
-void EMT::Ph1::VoltageSourceRamp::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void EMT::Ph1::VoltageSourceRamp::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 	mSubVoltageSource->mnaApplySystemMatrixStamp(systemMatrix);
 }
 
-void EMT::Ph1::VoltageSourceRamp::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
+void EMT::Ph1::VoltageSourceRamp::mnaApplyRightSideVectorStamp(RightVectorStamp& rightVector) {
 	mSubVoltageSource->mnaApplyRightSideVectorStamp(rightVector);
 }
 
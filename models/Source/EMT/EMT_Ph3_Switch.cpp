@@ -60,7 +60,7 @@ void EMT::Ph3::Switch::mnaInitialize(Real omega, Real timeStep, Attribute<Matrix
 	mMnaTasks.push_back(std::make_shared<MnaPostStep>(*this, leftVector));
 }
 
-void EMT::Ph3::Switch::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void EMT::Ph3::Switch::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 	Matrix conductance = (mSwitchClosed) ?
 		mClosedResistance.inverse() : mOpenResistance.inverse();
 
@@ -117,7 +117,7 @@ void EMT::Ph3::Switch::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
 		Logger::matrixToString(conductance));
 }
 
-void EMT::Ph3::Switch::mnaApplySwitchSystemMatrixStamp(Matrix& systemMatrix, Bool closed) {
+void EMT::Ph3::Switch::mnaApplySwitchSystemMatrixStamp(SparseMatrixRow& systemMatrix, Bool closed) {
 	Matrix conductance = (closed) ?
 		mClosedResistance.inverse() : mOpenResistance.inverse();
 
@@ -175,7 +175,7 @@ void EMT::Ph3::Switch::mnaApplySwitchSystemMatrixStamp(Matrix& systemMatrix, Boo
 		Logger::matrixToString(conductance));
 }
 
-void EMT::Ph3::Switch::mnaApplyRightSideVectorStamp(Matrix& rightVector) { }
+void EMT::Ph3::Switch::mnaApplyRightSideVectorStamp(RightVectorStamp& rightVector) { }
 
 void EMT::Ph3::Switch::MnaPostStep::execute(Real time, Int timeStepCount) {
 	mSwitch.mnaUpdateVoltage(*mLeftVector);
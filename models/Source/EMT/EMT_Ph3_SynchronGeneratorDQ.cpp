@@ -75,7 +75,7 @@ void EMT::Ph3::SynchronGeneratorDQ::initialize(Matrix frequencies) {
 	mIntfCurrent = mBase_I * dq0ToAbcTransform(mThetaMech, mIdq0);
 }
 
-void EMT::Ph3::SynchronGeneratorDQ::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void EMT::Ph3::SynchronGeneratorDQ::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 	if (!mCompensationOn)
 		return;
 
@@ -91,7 +91,7 @@ void EMT::Ph3::SynchronGeneratorDQ::mnaApplySystemMatrixStamp(Matrix& systemMatr
 	}
 }
 
-void EMT::Ph3::SynchronGeneratorDQ::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
+void EMT::Ph3::SynchronGeneratorDQ::mnaApplyRightSideVectorStamp(RightVectorStamp& rightVector) {
 	if (mCompensationOn)
 		mCompensationCurrent = mIntfVoltage / mRcomp;
 
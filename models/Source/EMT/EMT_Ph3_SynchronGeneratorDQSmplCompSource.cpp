@@ -90,7 +90,7 @@ void EMT::Ph3::SynchronGeneratorDQSmplCompSource::initialize(Real om, Real dt,
 }
 
 // TODO: fix voltage sources
-void EMT::Ph3::SynchronGeneratorDQSmplCompSource::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void EMT::Ph3::SynchronGeneratorDQSmplCompSource::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 	//va.setVirtualNode(0, mVirtualNodes[0]);
 	//vb.setVirtualNode(0, mVirtualNodes[1]);
 	//vc.setVirtualNode(0, mVirtualNodes[2]);
@@ -100,7 +100,7 @@ void EMT::Ph3::SynchronGeneratorDQSmplCompSource::mnaApplySystemMatrixStamp(Matr
 	vc.mnaApplySystemMatrixStamp(systemMatrix);
 }
 
-void EMT::Ph3::SynchronGeneratorDQSmplCompSource::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
+void EMT::Ph3::SynchronGeneratorDQSmplCompSource::mnaApplyRightSideVectorStamp(RightVectorStamp& rightVector) {
 	//va.setVirtualNode(0, mVirtualNodes[0]);
 	//vb.setVirtualNode(0, mVirtualNodes[1]);
 	//vc.setVirtualNode(0, mVirtualNodes[2]);